@@ -0,0 +1,215 @@
+/*
+ * SudokuBatch:
+ * Solves many puzzles at once by running naked and hidden single propagation
+ * in lock-step across the lanes of a Batch, one puzzle per lane.
+ * Puzzles that stall are handed to the scalar solver (solveLoop/guess).
+ *
+ * Created on 10/18/26.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "SudokuBatch.h"
+#include "SudokuTables.h"
+
+/*
+ * batchSolve:
+ * - Solves count boards loaded by initBoard, Lanes boards at a time
+ * Description:
+ * 1. Load a group of boards into the lanes of a batch
+ * 2. Propagate singles across all lanes until no lane changes
+ * 3. Store the lanes back into their boards, then finish any board that
+ *    still has empty cells with the scalar solver
+ * - Returns the number of boards that could not be solved
+ */
+int batchSolve(Board *boards, int count) {
+    int i, n, failed;
+    Batch batch;
+    failed = 0;
+    for (i = 0; i < count; i += Lanes) {
+        n = (count - i < Lanes) ? count - i : Lanes;
+        batchLoad(&batch, boards + i, n);
+        batchPropagate(&batch);
+        batchStore(&batch, boards + i);
+    }
+    for (i = 0; i < count; i++) {
+        if (!trivialTest(&boards[i])) {
+            solveLoop(&boards[i]);
+        }
+        if (!testBoard(&boards[i])) {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+/*
+ * batchLoad:
+ * - Interleaves up to Lanes boards into the batch
+ * - Filled cells become solved bits, empty cells start with every note set
+ * - Unused lanes are left empty, which propagation never changes
+ */
+void batchLoad(Batch *batch, Board *boards, int count) {
+    int i, l, val;
+    memset(batch, 0, sizeof(Batch));
+    batch -> count = count;
+    for (l = 0; l < count; l++) {
+        for (i = 0; i < BoardSize; i++) {
+            val = boards[l].values[i];
+            if (val != 0) {
+                batch -> solved[i][l] = (unsigned short) (1 << (val - 1));
+            } else {
+                batch -> notes[i][l] = AllNotes;
+            }
+        }
+    }
+}
+
+/*
+ * batchPropagate:
+ * - Repeats a round of clearing conflicts, naked singles, and hidden singles
+ *   until no lane changes
+ * - Conflicts are cleared after each placement step, so hidden singles are
+ *   always found on up to date notes
+ * - Returns the number of rounds run
+ */
+int batchPropagate(Batch *batch) {
+    int rounds, check;
+    rounds = 0;
+    do {
+        check = batchClear(batch);
+        check |= batchNakedSingles(batch);
+        check |= batchClear(batch);
+        check |= batchHiddenSingles(batch);
+        rounds++;
+    } while (check);
+    return rounds;
+}
+
+/*
+ * batchStore:
+ * - Writes each lane back into its board, including the notes of empty cells,
+ *   so that the scalar solver can carry on from where propagation stopped
+ */
+void batchStore(Batch *batch, Board *boards) {
+    int i, l, solved;
+    for (l = 0; l < batch -> count; l++) {
+        boards[l].depth = 0;
+        memset(boards[l].reasons, 0, sizeof(boards[l].reasons));
+        memset(boards[l].setConflicts, 0, sizeof(boards[l].setConflicts));
+        for (i = 0; i < BoardSize; i++) {
+            solved = batch -> solved[i][l];
+            if (solved) {
+                boards[l].values[i] = (unsigned char) (firstNote(solved) + 1);
+                setEmpty(&boards[l], i);
+            } else {
+                boards[l].values[i] = 0;
+                boards[l].notes[i] = batch -> notes[i][l];
+                boards[l].noteCount[i] = (unsigned char) countNotes(batch -> notes[i][l]);
+            }
+        }
+    }
+}
+
+/*
+ * Lock-step Functions:
+ * Each function works on every lane with the same sequence of operations,
+ * using masks in place of branches. They return 1 if any lane changed.
+ */
+
+/*
+ * batchClear:
+ * - Removes every value placed in a set from the notes of the set's cells
+ */
+int batchClear(Batch *batch) {
+    int set, i, l, cell;
+    unsigned short placed[Lanes], changed[Lanes], notes;
+    memset(changed, 0, sizeof(changed));
+    for (set = 0; set < 27; set++) {
+        memset(placed, 0, sizeof(placed));
+        for (i = 0; i < 9; i++) {
+            cell = units[set][i];
+            for (l = 0; l < Lanes; l++) {
+                placed[l] |= batch -> solved[cell][l];
+            }
+        }
+        for (i = 0; i < 9; i++) {
+            cell = units[set][i];
+            for (l = 0; l < Lanes; l++) {
+                notes = batch -> notes[cell][l] & ~placed[l];
+                changed[l] |= notes ^ batch -> notes[cell][l];
+                batch -> notes[cell][l] = notes;
+            }
+        }
+    }
+    for (l = 1; l < Lanes; l++) {
+        changed[0] |= changed[l];
+    }
+    return changed[0] != 0;
+}
+
+/*
+ * batchNakedSingles:
+ * - Solves every empty cell that has exactly one note left
+ */
+int batchNakedSingles(Batch *batch) {
+    int i, l;
+    unsigned short changed[Lanes], notes, single;
+    memset(changed, 0, sizeof(changed));
+    for (i = 0; i < BoardSize; i++) {
+        for (l = 0; l < Lanes; l++) {
+            notes = batch -> notes[i][l];
+            single = (unsigned short) -(notes != 0 && (notes & (notes - 1)) == 0);
+            batch -> solved[i][l] |= notes & single;
+            batch -> notes[i][l] = notes & ~single;
+            changed[l] |= notes & single;
+        }
+    }
+    for (l = 1; l < Lanes; l++) {
+        changed[0] |= changed[l];
+    }
+    return changed[0] != 0;
+}
+
+/*
+ * batchHiddenSingles:
+ * - Solves every cell holding the only copy of a note in one of its sets
+ * - once/twice track which notes appear at least once or at least twice in the set
+ * - Values already placed in the set are never placed again
+ */
+int batchHiddenSingles(Batch *batch) {
+    int set, i, l, cell;
+    unsigned short once[Lanes], twice[Lanes], placed[Lanes], changed[Lanes];
+    unsigned short notes, hit, single;
+    memset(changed, 0, sizeof(changed));
+    for (set = 0; set < 27; set++) {
+        memset(once, 0, sizeof(once));
+        memset(twice, 0, sizeof(twice));
+        memset(placed, 0, sizeof(placed));
+        for (i = 0; i < 9; i++) {
+            cell = units[set][i];
+            for (l = 0; l < Lanes; l++) {
+                notes = batch -> notes[cell][l];
+                twice[l] |= once[l] & notes;
+                once[l] |= notes;
+                placed[l] |= batch -> solved[cell][l];
+            }
+        }
+        for (i = 0; i < 9; i++) {
+            cell = units[set][i];
+            for (l = 0; l < Lanes; l++) {
+                notes = batch -> notes[cell][l];
+                hit = notes & once[l] & ~twice[l] & ~placed[l];
+                single = (unsigned short) -(hit != 0 && (hit & (hit - 1)) == 0);
+                batch -> solved[cell][l] |= hit & single;
+                batch -> notes[cell][l] = notes & ~single;
+                placed[l] |= hit & single;
+                changed[l] |= hit & single;
+            }
+        }
+    }
+    for (l = 1; l < Lanes; l++) {
+        changed[0] |= changed[l];
+    }
+    return changed[0] != 0;
+}
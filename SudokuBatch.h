@@ -0,0 +1,40 @@
+//
+// Created on 10/18/26.
+//
+
+#ifndef SUDOKU_SUDOKUBATCH_H
+#define SUDOKU_SUDOKUBATCH_H
+
+#include <stdio.h>
+#include "SudokuChecker.h"
+
+#define Lanes 16
+
+typedef struct Batch Batch;
+
+/*
+ * Batch struct:
+ * Holds up to Lanes puzzles interleaved so that lane l of every row belongs
+ * to puzzle l. Each step of propagation runs over all lanes at once, which
+ * lets the compiler turn the lane loops into vector instructions.
+ * - solved -> bit n is set when the cell holds n + 1 (0 if empty)
+ * - notes -> bit n is set when n + 1 could viably go in an empty cell
+ * - count -> how many lanes hold a puzzle
+ */
+struct Batch {
+    unsigned short solved[BoardSize][Lanes];
+    unsigned short notes[BoardSize][Lanes];
+    int count;
+};
+
+int batchSolve(Board *boards, int count);
+
+void batchLoad(Batch *batch, Board *boards, int count);
+int batchPropagate(Batch *batch);
+void batchStore(Batch *batch, Board *boards);
+
+int batchClear(Batch *batch);
+int batchNakedSingles(Batch *batch);
+int batchHiddenSingles(Batch *batch);
+
+#endif //SUDOKU_SUDOKUBATCH_H
@@ -0,0 +1,150 @@
+/*
+ * SudokuBulk:
+ * Implements the bulk C API in SudokuBulk.h.
+ * The puzzle array is split into one contiguous shard per thread, and each
+ * shard is solved Lanes puzzles at a time with batchSolve.
+ *
+ * Created on 10/18/26.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "SudokuBulk.h"
+#include "SudokuBatch.h"
+
+#define MaxThreads 256
+
+typedef struct Shard Shard;
+
+/*
+ * Shard struct:
+ * The part of the caller's buffers that one thread solves
+ * - solved -> how many puzzles of the shard were solved
+ */
+struct Shard {
+    const uint8_t *input;
+    uint8_t *output;
+    int32_t *status;
+    int64_t count;
+    int64_t solved;
+};
+
+void *solveShard(void *arg);
+
+SUDOKU_API int64_t sudokuSolveBulk(const uint8_t *input, uint8_t *output,
+                                   int32_t *status, int64_t count, int32_t threads) {
+    Shard shards[MaxThreads];
+    pthread_t workers[MaxThreads];
+    int started[MaxThreads];
+    int64_t first, size, solved;
+    int t;
+
+    if (!input || !output || count < 0) {
+        return -1;
+    }
+    if (threads <= 0) {
+        threads = (int32_t) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    if (threads > MaxThreads) {
+        threads = MaxThreads;
+    }
+    //keep at least a full batch of puzzles per thread
+    if (threads > (count + Lanes - 1) / Lanes) {
+        threads = (int32_t) ((count + Lanes - 1) / Lanes);
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    /*
+     * Shards are whole multiples of Lanes, except for the last one,
+     * so that every batch but the final one is full
+     */
+    size = (count + threads - 1) / threads;
+    size = (size + Lanes - 1) / Lanes * Lanes;
+    for (t = 0; t < threads; t++) {
+        first = t * size < count ? t * size : count;
+        shards[t].input = input + BoardSize * first;
+        shards[t].output = output + BoardSize * first;
+        shards[t].status = status ? status + first : NULL;
+        shards[t].count = (first + size < count ? first + size : count) - first;
+        shards[t].solved = 0;
+    }
+
+    //the calling thread solves the first shard, and any shard a thread could not start for
+    for (t = 1; t < threads; t++) {
+        started[t] = pthread_create(&workers[t], NULL, solveShard, &shards[t]) == 0;
+    }
+    solveShard(&shards[0]);
+    solved = shards[0].solved;
+    for (t = 1; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(workers[t], NULL);
+        } else {
+            solveShard(&shards[t]);
+        }
+        solved += shards[t].solved;
+    }
+    return solved;
+}
+
+SUDOKU_API int32_t sudokuApiVersion(void) {
+    return SUDOKU_API_VERSION;
+}
+
+/*
+ * solveShard:
+ * - Solves a shard Lanes puzzles at a time, using boards on the stack
+ * - Boards are loaded straight from the input bytes and written straight
+ *   to the output bytes, with no text parsing
+ */
+void *solveShard(void *arg) {
+    Shard *shard = (Shard*) arg;
+    Board boards[Lanes];
+    int invalid[Lanes];
+    int64_t first;
+    int i, l, n;
+    const uint8_t *puzzle;
+    uint8_t *solution;
+
+    for (first = 0; first < shard -> count; first += Lanes) {
+        n = shard -> count - first < Lanes ? (int) (shard -> count - first) : Lanes;
+        for (l = 0; l < n; l++) {
+            puzzle = shard -> input + BoardSize * (first + l);
+            invalid[l] = 0;
+            for (i = 0; i < BoardSize; i++) {
+                if (puzzle[i] > 9) {
+                    invalid[l] = 1;
+                }
+                boards[l].values[i] = puzzle[i] <= 9 ? puzzle[i] : 0;
+            }
+            boards[l].guesses = 0;
+            clearConflict(&boards[l]);
+        }
+
+        batchSolve(boards, n);
+
+        for (l = 0; l < n; l++) {
+            puzzle = shard -> input + BoardSize * (first + l);
+            solution = shard -> output + BoardSize * (first + l);
+            if (!invalid[l] && testBoard(&boards[l])) {
+                memcpy(solution, boards[l].values, BoardSize);
+                shard -> solved++;
+                if (shard -> status) {
+                    shard -> status[first + l] = boards[l].guesses;
+                }
+            } else {
+                memmove(solution, puzzle, BoardSize);
+                if (shard -> status) {
+                    shard -> status[first + l] = invalid[l] ? SUDOKU_INVALID : SUDOKU_UNSOLVED;
+                }
+            }
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,61 @@
+//
+// Created on 10/18/26.
+//
+
+#ifndef SUDOKU_SUDOKUBULK_H
+#define SUDOKU_SUDOKUBULK_H
+
+/*
+ * Bulk C API:
+ * Solves caller-owned arrays of puzzles in place, for use from other
+ * languages (e.g. Python ctypes/cffi with NumPy uint8[N][81] arrays).
+ * Only the functions in this header are exported from the shared library,
+ * and their signatures only use fixed-width types.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(SUDOKU_LIBRARY) && defined(__GNUC__)
+#define SUDOKU_API __attribute__((visibility("default")))
+#else
+#define SUDOKU_API
+#endif
+
+#define SUDOKU_API_VERSION 1
+
+/*
+ * Per-puzzle status codes (a status of 0 or more is the guess count of a solved puzzle)
+ */
+#define SUDOKU_UNSOLVED (-1)    //the puzzle has no solution
+#define SUDOKU_INVALID (-2)     //the puzzle holds a value outside 0-9
+
+/*
+ * sudokuSolveBulk:
+ * - input -> count puzzles of 81 bytes each, row-major, 0 for an empty cell
+ * - output -> count * 81 bytes for the solutions, either the same buffer as input
+ *   (solve in place) or one that does not overlap it. Puzzles that cannot be
+ *   solved are copied through unchanged.
+ * - status -> count entries set to the guess count, or a SUDOKU_* code on failure.
+ *   May be NULL.
+ * - threads -> how many threads to solve with, 0 for one per online CPU
+ * - Returns the number of puzzles solved, or -1 if input or output is NULL
+ * No memory is allocated per puzzle; each thread works on the buffers directly.
+ */
+SUDOKU_API int64_t sudokuSolveBulk(const uint8_t *input, uint8_t *output,
+                                   int32_t *status, int64_t count, int32_t threads);
+
+/*
+ * sudokuApiVersion: Returns SUDOKU_API_VERSION of the library
+ */
+SUDOKU_API int32_t sudokuApiVersion(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SUDOKU_SUDOKUBULK_H
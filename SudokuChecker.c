@@ -3,30 +3,27 @@
  * Solves sudoku puzzles using a combination of logical deduction and guessing
  *
  * Created by: Riley Peters
- * Version 1.3
+ * Version 1.4
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
 #include "SudokuChecker.h"
+#include "SudokuTables.h"
+#include "SudokuBatch.h"
+#include "SudokuPack.h"
+#include "SudokuTrace.h"
+#include "SudokuSession.h"
 
 #define STD_OUT 2
 #define FILE_OUT 3
+#define RANGE_OUT 5
+#define LineSize 256
 
-/*
- * Global Variables:
- * 1. board:
- * 9x9 array of Cells that stores the
- * data required to solve the sudoku puzzle
- * 2. paths:
- * 27x9 array of Cell pointers configured to show
- * all possible sets of cells.
- * 0-8 rows, 9-17 columns, 18-26 squares
- */
-Cell board[Rows][Columns];
-Cell *paths[27][9];
-int guesses = 0;
-
+#ifndef SUDOKU_LIBRARY
 /*
  * sudokuChecker:
  * - Takes in an input and output file
@@ -38,6 +35,10 @@ int guesses = 0;
  */
 int main(int argc, char *argv[]) {
     FILE *infile, *outfile;
+    Board board;
+    if (argc > 1 && argv[1][0] == '-') {
+        return modeMain(argc, argv);
+    }
     switch(argc) {
         case STD_OUT:
             outfile = stdout;
@@ -60,7 +61,7 @@ int main(int argc, char *argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    if (initBoard(infile) == -1) {
+    if (initBoard(&board, infile) == -1) {
         fprintf(stderr, "Error: Improper Input Formatting\n"
                         "Make sure each cell is indicated by a number (1-9)\n"
                         "if filled, or space if empty, "
@@ -68,18 +69,387 @@ int main(int argc, char *argv[]) {
         exit(EXIT_FAILURE);
     }
 
-    definePaths();
-    if (!solve() && testBoard()) {
-        outputBoard(outfile);
+    if (!solve(&board) && testBoard(&board)) {
+        outputBoard(&board, outfile);
     } else {
         fprintf(stderr, "Could Not Compute a Solution");
     }
 
     return 0;
 }
+#endif //SUDOKU_LIBRARY
+
+/*
+ * modeMain:
+ * - Runs one of the multi-puzzle modes selected by the flag in argv[1]
+ * - Each mode is passed the arguments after the program name, so that
+ *   argv[1] is the input file, argv[2] the optional output file, and
+ *   argv[3] and argv[4] an optional range of puzzles to read
+ */
+int modeMain(int argc, char *argv[]) {
+    if (argc != STD_OUT + 1 && argc != FILE_OUT + 1 && argc != RANGE_OUT + 1) {
+        fprintf(stderr, "Invalid Arguments");
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    switch(argv[1][1]) {
+        case 'b':
+            return batchMain(argc - 1, argv + 1);
+        case 'p':
+            return packMain(argc - 1, argv + 1, 0);
+        case 'P':
+            return packMain(argc - 1, argv + 1, 1);
+        case 'u':
+            return unpackMain(argc - 1, argv + 1);
+        case 't':
+            return benchMain(argc - 1, argv + 1);
+        case 'j':
+            return traceMain(argc - 1, argv + 1, 0);
+        case 'l':
+            return traceMain(argc - 1, argv + 1, 1);
+        case 's':
+            return sessionMain(argc - 1, argv + 1);
+        default:
+            fprintf(stderr, "Invalid Arguments");
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * batchMain (-b infile [outfile [first count]]):
+ * - Reads the puzzles in infile Lanes at a time and solves each group with batchSolve
+ * - Each solution is written to outfile in the order it was read,
+ *   puzzles that could not be solved get an error line in place of the grid
+ */
+int batchMain(int argc, char *argv[]) {
+    FILE *outfile;
+    Reader reader;
+    Board boards[Lanes];
+    int i, n, count, failed;
+    outfile = openOutput(argc, argv, "w");
+    openInput(&reader, argc, argv);
+
+    count = failed = 0;
+    while ((n = nextBoards(&reader, boards, Lanes)) > 0) {
+        failed += batchSolve(boards, n);
+        for (i = 0; i < n; i++) {
+            if (testBoard(&boards[i])) {
+                writeBoard(&boards[i], outfile);
+            } else {
+                fprintf(outfile, "Puzzle %d: Could Not Compute a Solution\n",
+                        reader.next - n + i + 1);
+            }
+            fputc('\n', outfile);
+        }
+        count += n;
+    }
+    fprintf(outfile, "Solved: %d of %d\n", count - failed, count);
+    fclose(outfile);
+    readerClose(&reader);
+    return 0;
+}
+
+/*
+ * packMain (-p / -P infile [outfile [first count]]):
+ * - Converts the puzzles in infile to the packed format (see SudokuPack.h),
+ *   reading and writing them Lanes at a time
+ * - With -P every puzzle is also solved, and the solutions are stored.
+ *   Puzzles that could not be solved are reported on stderr and stored
+ *   with the PackNoSolution record, so the rest of the file is still packed.
+ */
+int packMain(int argc, char *argv[], int withSolutions) {
+    FILE *outfile;
+    Reader reader;
+    Writer writer;
+    Board puzzles[Lanes], solutions[Lanes];
+    int i, n;
+    outfile = openOutput(argc, argv, "wb");
+    openInput(&reader, argc, argv);
+    if (writerOpen(&writer, outfile, withSolutions) == -1) {
+        perror("Could Not Write Packed File");
+        exit(EXIT_FAILURE);
+    }
+
+    while ((n = nextBoards(&reader, puzzles, Lanes)) > 0) {
+        if (withSolutions) {
+            memcpy(solutions, puzzles, n * sizeof(Board));
+            batchSolve(solutions, n);
+        }
+        for (i = 0; i < n; i++) {
+            if (withSolutions && !testBoard(&solutions[i])) {
+                fprintf(stderr, "Puzzle %d: Could Not Compute a Solution\n", reader.next - n + i + 1);
+            }
+            if (writerAdd(&writer, &puzzles[i], withSolutions && testBoard(&solutions[i]) ? &solutions[i] : NULL) == -1) {
+                perror("Could Not Write Packed File");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+    if (writerClose(&writer) == -1) {
+        perror("Could Not Write Packed File");
+        exit(EXIT_FAILURE);
+    }
+    fclose(outfile);
+    readerClose(&reader);
+    return 0;
+}
+
+/*
+ * unpackMain (-u infile [outfile [first count]]):
+ * - Writes the puzzles in infile back out in the text format read by initBoard
+ */
+int unpackMain(int argc, char *argv[]) {
+    FILE *outfile;
+    Reader reader;
+    Board boards[Lanes];
+    int i, n;
+    outfile = openOutput(argc, argv, "w");
+    openInput(&reader, argc, argv);
+    while ((n = nextBoards(&reader, boards, Lanes)) > 0) {
+        for (i = 0; i < n; i++) {
+            writePuzzle(&boards[i], outfile);
+            fputc('\n', outfile);
+        }
+    }
+    fclose(outfile);
+    readerClose(&reader);
+    return 0;
+}
+
+/*
+ * benchMain (-t infile [outfile [first count]]):
+ * - Times batchSolve on the puzzles in infile and reports puzzles per second
+ * - Only solving is timed, not reading the puzzles
+ * - If infile is a packed file with solutions, the results are checked against them
+ *   (a puzzle stored as having no solution only matches if it also fails here)
+ */
+int benchMain(int argc, char *argv[]) {
+    FILE *outfile;
+    Reader reader;
+    Board boards[Lanes];
+    Board solution;
+    int i, n, count, failed, wrong;
+    clock_t start, ticks;
+    double seconds;
+    outfile = openOutput(argc, argv, "w");
+    openInput(&reader, argc, argv);
+
+    count = failed = wrong = 0;
+    ticks = 0;
+    while ((n = nextBoards(&reader, boards, Lanes)) > 0) {
+        start = clock();
+        failed += batchSolve(boards, n);
+        ticks += clock() - start;
+        for (i = 0; reader.pack.solutions && i < n; i++) {
+            if (packSolution(&reader.pack, reader.next - n + i, &solution) == 0 ?
+                memcmp(solution.values, boards[i].values, BoardSize) != 0 : testBoard(&boards[i])) {
+                wrong++;
+            }
+        }
+        count += n;
+    }
+    seconds = (double) ticks / CLOCKS_PER_SEC;
+
+    fprintf(outfile, "Puzzles: %d\nFailed: %d\nMismatched: %d\n", count, failed, wrong);
+    fprintf(outfile, "Seconds: %.3f\nPuzzles/sec: %.0f\n", seconds,
+            seconds > 0 ? count / seconds : 0.0);
+    fclose(outfile);
+    readerClose(&reader);
+    return 0;
+}
+
+/*
+ * traceMain (-j / -l infile [outfile [first count]]):
+ * - Solves the puzzles in infile with the tracer running, marking where
+ *   each puzzle begins and ends
+ * - With -j the trace is written as Chrome trace-event JSON,
+ *   with -l as a compact binary log (see SudokuTrace.c)
+ */
+int traceMain(int argc, char *argv[], int binary) {
+    FILE *outfile;
+    Reader reader;
+    Board boards[Lanes];
+    Trace *trace;
+    int i, n, status;
+    outfile = openOutput(argc, argv, binary ? "wb" : "w");
+    openInput(&reader, argc, argv);
+    if (traceStart(TraceCapacity) == -1) {
+        perror("Could Not Allocate Trace");
+        exit(EXIT_FAILURE);
+    }
+    while ((n = nextBoards(&reader, boards, Lanes)) > 0) {
+        for (i = 0; i < n; i++) {
+            TRACE(traceBegin(reader.next - n + i));
+            solve(&boards[i]);
+            TRACE(traceEnd(testBoard(&boards[i])));
+        }
+    }
+    trace = traceStop();
+
+    status = binary ? traceWriteLog(trace, outfile) : traceWriteJson(trace, outfile);
+    if (status == -1) {
+        perror("Could Not Write Trace");
+        exit(EXIT_FAILURE);
+    }
+    fclose(outfile);
+    traceFree(trace);
+    readerClose(&reader);
+    return 0;
+}
+
+/*
+ * sessionMain (-s infile [outfile [first count]]):
+ * - Starts an interactive session (see SudokuSession.h) from the first puzzle
+ *   in infile, then replays the commands read from stdin, one per line:
+ *      p row col val -> place val in the cell (rows and columns count from 1)
+ *      c row col -> clear the cell
+ *      h -> write the next logical step
+ *      b -> write the board
+ * - Blank lines and lines starting with # are skipped
+ * - A command that cannot be carried out (including an edit to one of the
+ *   puzzle's givens) gets an error line in outfile, and the rest of the
+ *   commands still run
+ * - A placement that puts a value twice in one set is kept, but noted in outfile
+ */
+int sessionMain(int argc, char *argv[]) {
+    FILE *outfile;
+    Reader reader;
+    Board board;
+    Session session;
+    Hint hint;
+    char line[LineSize];
+    int lineNumber, row, col, val, cell, status;
+    outfile = openOutput(argc, argv, "w");
+    openInput(&reader, argc, argv);
+    if (nextBoards(&reader, &board, 1) != 1) {
+        fprintf(stderr, "Error: No Puzzle in Input File\n");
+        exit(EXIT_FAILURE);
+    }
+    readerClose(&reader);
+    sessionInit(&session, &board);
+
+    for (lineNumber = 1; fgets(line, LineSize, stdin); lineNumber++) {
+        status = 0;
+        row = col = 0;
+        switch (line[0]) {
+            case 'p':
+                status = sscanf(line + 1, "%d %d %d", &row, &col, &val) == 3 ? 0 : -1;
+                break;
+            case 'c':
+                status = sscanf(line + 1, "%d %d", &row, &col) == 2 ? 0 : -1;
+                break;
+            case 'h':
+                sessionHint(&session, &hint);
+                writeHint(&hint, outfile);
+                break;
+            case 'b':
+                writePuzzle(&session.board, outfile);
+                break;
+            case '#':
+            case '\n':
+            case '\r':
+                break;
+            default:
+                status = -1;
+                break;
+        }
+        if (status == 0 && (line[0] == 'p' || line[0] == 'c')) {
+            if (row < 1 || row > Rows || col < 1 || col > Columns) {
+                status = -1;
+            } else if (session.given[cell = 9 * (row - 1) + col - 1]) {
+                fprintf(outfile, "Error: r%dc%d is a Given on line %d\n", row, col, lineNumber);
+                continue;
+            } else {
+                status = line[0] == 'p' ? sessionPlace(&session, cell, val) : sessionClear(&session, cell);
+            }
+        }
+        if (status == -1) {
+            fprintf(outfile, "Error: Invalid Command on line %d\n", lineNumber);
+        } else if (status == 1) {
+            fprintf(outfile, "Duplicate: r%dc%d = %d is already in ", row, col, val);
+            writeSet(session.board.conflict.set, outfile);
+            fprintf(outfile, " at r%dc%d\n", session.board.conflict.other / 9 + 1,
+                    session.board.conflict.other % 9 + 1);
+        }
+    }
+    fclose(outfile);
+    return 0;
+}
+
+/*
+ * openOutput:
+ * - Returns stdout if no output file was given (or it was "-"), or opens argv[2] with mode
+ */
+FILE *openOutput(int argc, char *argv[], const char *mode) {
+    FILE *outfile;
+    switch(argc) {
+        case STD_OUT:
+            return stdout;
+        case FILE_OUT:
+        case RANGE_OUT:
+            if (strcmp(argv[2], "-") == 0) {
+                return stdout;
+            }
+            outfile = fopen(argv[2], mode);
+            if (!outfile) {
+                perror("Invalid Output File");
+                exit(EXIT_FAILURE);
+            }
+            return outfile;
+        default:
+            fprintf(stderr, "Invalid Arguments");
+            exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * openInput:
+ * - Opens argv[1] as a text or packed puzzle file
+ * - If argv[3] and argv[4] are given, only count puzzles are read starting
+ *   from puzzle number first (counting from 0), so that one file can be
+ *   split between several runs
+ */
+void openInput(Reader *reader, int argc, char *argv[]) {
+    long first, count;
+    char *end;
+    first = 0;
+    count = -1;
+    if (argc == RANGE_OUT) {
+        first = strtol(argv[3], &end, 10);
+        if (*end != '\0' || first < 0 || first > INT_MAX) {
+            fprintf(stderr, "Invalid Arguments");
+            exit(EXIT_FAILURE);
+        }
+        count = strtol(argv[4], &end, 10);
+        if (*end != '\0' || count < 0 || count > INT_MAX - first) {
+            fprintf(stderr, "Invalid Arguments");
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (readerOpen(reader, argv[1], (int) first, (int) count) == -1) {
+        fprintf(stderr, "Error: Invalid Input File\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * nextBoards:
+ * - Loads up to max of the next puzzles with readerNext
+ * - Exits with an error if a puzzle is malformed, rather than
+ *   stopping quietly at the puzzles read before it
+ */
+int nextBoards(Reader *reader, Board *boards, int max) {
+    int n = readerNext(reader, boards, max);
+    if (n == -1) {
+        fprintf(stderr, "Error: Improper Input Formatting in puzzle %d\n", reader -> next + 1);
+        exit(EXIT_FAILURE);
+    }
+    return n;
+}
 
 void usage(char *arg) {
-    fprintf(stderr, "%s infile outfile", arg);
+    fprintf(stderr, "%s [-b | -p | -P | -u | -t | -j | -l | -s] infile outfile [first count]", arg);
 }
 
 /*
@@ -90,74 +460,117 @@ void usage(char *arg) {
  * 4. If an improper amount of characters is received, the program terminates
  *      with error code -1;
  */
-int initBoard(FILE *file) {
-    int i, c, modified, row, column;
+int initBoard(Board *board, FILE *file) {
+    int status = readBoard(board, file);
+    fclose(file);
+    return status == 0 ? 0 : -1;
+}
+
+/*
+ * readBoard:
+ * - Parses the next board from the file without closing it, so that
+ *   several boards can be read from one file
+ * - Lines before the board that are not grid rows (blank lines, or notes
+ *   written after the previous board) are skipped
+ * - Once the board has started, every line must be a grid row until
+ *   all of its cells have been read
+ * - Returns 1 if the file ends before another board starts, or -1 if the
+ *   board is cut short or a row runs past the end of the board
+ */
+int readBoard(Board *board, FILE *file) {
+    char line[LineSize];
+    const char *c;
+    int i, cells, modified;
     i = modified = 0;
-    while(i < BoardSize && (c = fgetc(file)) != EOF) {
-        row = i / 9;
-        column = i % 9;
-        if (modified == 0 && (c >= '1' && c <= '9')) {
-            Cell currentCell;
-            currentCell.value = (c - '0');
-            currentCell.row = row;
-            currentCell.col = column;
-            board[row][column] = currentCell;
-            modified = 1;
-        } else if (c == ',') {
-            if (modified == 0) {
-                Cell currentCell;
-                currentCell.value = 0;
-                currentCell.row = row;
-                currentCell.col = column;
-                board[row][column] = currentCell;
+    board -> guesses = 0;
+    clearConflict(board);
+    while (i < BoardSize && fgets(line, LineSize, file)) {
+        cells = gridRow(line);
+        if (cells == 0 && i == 0) {
+            continue;
+        }
+        if (cells == 0 || i + cells > BoardSize) {
+            return -1;   //error: board not filled, or too many cells
+        }
+        for (c = line; *c; c++) {
+            if (modified == 0 && (*c >= '1' && *c <= '9')) {
+                board -> values[i] = (unsigned char) (*c - '0');
+                modified = 1;
+            } else if (*c == ',') {
+                if (modified == 0) {
+                    board -> values[i] = 0;
+                }
+                modified = 0;
+                i++;
             }
-            modified = 0;
-            i++;
         }
     }
-    fclose(file);
 
+    if (i == 0) {
+        return 1;    //no more boards
+    }
     if (i != BoardSize) {
         return -1;   //error: board not filled
     }
     return 0;
 }
 
-void outputBoard(FILE *file) {
-    int r, c;
-    for (r = 0; r < Rows; r++) {
-        for (c = 0; c < Columns; c++) {
-            fprintf(file, "%d, ", board[r][c].value);
+/*
+ * gridRow:
+ * - Returns how many cells a line holds if it is a grid row, or 0 if not
+ * - A grid row holds only digits, blanks, and at least one comma
+ *   (one after each cell)
+ */
+int gridRow(const char *line) {
+    int cells = 0;
+    for (; *line; line++) {
+        if (*line == ',') {
+            cells++;
+        } else if ((*line < '0' || *line > '9') && *line != ' ' && *line != '\t'
+                   && *line != '\r' && *line != '\n') {
+            return 0;
         }
-        fputc('\n', file);
     }
-    fprintf(file, "\nGuesses: %d\n", guesses);
-    fclose(file);
+    return cells;
+}
 
+void outputBoard(Board *board, FILE *file) {
+    writeBoard(board, file);
+    fclose(file);
 }
 
-void definePaths() {
-    int i, r, c, s, p;
-    i = 0;
+/*
+ * writeBoard:
+ * - Writes the board values and guess count without closing the file
+ */
+void writeBoard(Board *board, FILE *file) {
+    int r, c;
     for (r = 0; r < Rows; r++) {
         for (c = 0; c < Columns; c++) {
-            paths[i][c] = &board[r][c];
-        }
-        i++;
-    }
-
-    for (c = 0; c < Columns; c++) {
-        for (r = 0; r < Rows; r++) {
-            paths[i][r] = &board[r][c];
+            fprintf(file, "%d, ", board -> values[9 * r + c]);
         }
-        i++;
+        fputc('\n', file);
     }
+    fprintf(file, "\nGuesses: %d\n", board -> guesses);
+}
 
-    for (s = 0; s < Squares; s++) {
-        for (p = 0; p < 9; p++) {
-            paths[i][p] = &board[getRow(s, p)][getCol(s, p)];
+/*
+ * writePuzzle:
+ * - Writes the board values in the comma separated input format,
+ *   with a space for each empty cell
+ */
+void writePuzzle(Board *board, FILE *file) {
+    int r, c, val;
+    for (r = 0; r < Rows; r++) {
+        for (c = 0; c < Columns; c++) {
+            val = board -> values[9 * r + c];
+            if (c != 0) {
+                fputc(' ', file);
+            }
+            fputc(val ? '0' + val : ' ', file);
+            fputc(',', file);
         }
-        i++;
+        fputc('\n', file);
     }
 }
 
@@ -165,14 +578,15 @@ void definePaths() {
  * Prints each board position, along with its value and notes
  *
  */
-void printBoard() {
-    int r, c, s, p, n;
+void printBoard(Board *board) {
+    int r, c, s, p, n, cell;
     printf("Row-wise:\n");
     for (r = 0; r < Rows; r++) {
         for (c = 0; c < Columns; c++) {
-            printf("(row: %d, column: %d) = %d\n\t", r, c, board[r][c].value);
+            cell = units[r][c];
+            printf("(row: %d, column: %d) = %d\n\t", r, c, board -> values[cell]);
             for (n = 0; n < 9; n++) {
-                if (board[r][c].notes[n] != 0) {
+                if (board -> notes[cell] & (1 << n)) {
                     printf("%d, ", n + 1);
                 }
             }
@@ -183,9 +597,10 @@ void printBoard() {
     printf("Column-wise:\n");
     for (c = 0; c < Columns; c++) {
         for (r = 0; r < Rows; r++) {
-            printf("(column: %d, row: %d) = %d\n\t", c, r, board[r][c].value);
+            cell = units[9 + c][r];
+            printf("(column: %d, row: %d) = %d\n\t", c, r, board -> values[cell]);
             for (n = 0; n < 9; n++) {
-                if (board[r][c].notes[n] != 0) {
+                if (board -> notes[cell] & (1 << n)) {
                     printf("%d, ", n + 1);
                 }
             }
@@ -196,10 +611,10 @@ void printBoard() {
     printf("Square-wise:\n");
     for (s = 0; s < Squares; s++) {
         for (p = 0; p < 9; p++) {
-            printf("(square: %d, pos: %d) = %d\n\t", s,
-                   p, board[getRow(s, p)][getCol(s, p)].value);
+            cell = units[18 + s][p];
+            printf("(square: %d, pos: %d) = %d\n\t", s, p, board -> values[cell]);
             for (n = 0; n < 9; n++) {
-                if (board[getRow(s, p)][getCol(s, p)].notes[n] != 0) {
+                if (board -> notes[cell] & (1 << n)) {
                     printf("%d, ", n + 1);
                 }
             }
@@ -209,18 +624,18 @@ void printBoard() {
     }
     for (r = 0; r < Rows; r++) {
         for (c = 0; c < Columns; c++) {
-            printf("%d, ", board[r][c].value);
+            printf("%d, ", board -> values[9 * r + c]);
         }
         printf("\n");
     }
 }
 
-void printCell(Cell *cell) {
+void printCell(Board *board, int cell) {
     int i;
-    printf("(row: %d, col: %d)\n", cell -> row, cell -> col);
-    printf("Value: %d\n", cell -> value);
+    printf("(row: %d, col: %d)\n", cell / 9, cell % 9);
+    printf("Value: %d\n", board -> values[cell]);
     for (i = 0; i < 9; i++) {
-        if (cell -> notes[i] == 1) {
+        if (board -> notes[cell] & (1 << i)) {
             printf("%d, ", i + 1);
         }
     }
@@ -230,47 +645,45 @@ void printCell(Cell *cell) {
 /*
  * Runs multiple tests to confirm if a board is solved
  */
-int testBoard() {
-    return (trivialTest() && setTest());
+int testBoard(Board *board) {
+    return (trivialTest(board) && setTest(board));
 }
 
-int trivialTest() {
-    int r, c;
-    for (r = 0; r < Rows; r++) {
-        for (c = 0; c < Columns; c++) {
-            if (board[r][c].value == 0) {
-                return 0;
-            }
+int trivialTest(Board *board) {
+    int i;
+    for (i = 0; i < BoardSize; i++) {
+        if (board -> values[i] == 0) {
+            return 0;
         }
     }
     return 1;
 }
 
-int setTest() {
-    int i, n;
+int setTest(Board *board) {
+    int i, n, seen;
     for (i = 0; i < 27; i++) {
-        int nums[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+        seen = 0;
         for (n = 0; n < 9; n++) {
-            nums[paths[i][n] -> value - 1] += 1;
+            seen |= 1 << (board -> values[units[i][n]] - 1);
         }
-        for (n = 0; n < 9; n++) {
-            if (nums[n] != 1) {
-                return 0;
-            }
+        if (seen != AllNotes) {
+            return 0;
         }
     }
     return 1;
 }
 
-int annotateBoard() {
-    int r, c;
-    for (r = 0; r < Rows; r++) {
-        for (c = 0; c < Columns; c++) {
-            if (board[r][c].value != 0) {
-                setEmpty(&board[r][c]);
-            } else {
-                setFull(&board[r][c]);
-            }
+int annotateBoard(Board *board) {
+    int i;
+    board -> depth = 0;
+    memset(board -> reasons, 0, sizeof(board -> reasons));
+    memset(board -> setConflicts, 0, sizeof(board -> setConflicts));
+    clearConflict(board);
+    for (i = 0; i < BoardSize; i++) {
+        if (board -> values[i] != 0) {
+            setEmpty(board, i);
+        } else {
+            setFull(board, i);
         }
     }
     return 0;
@@ -281,19 +694,27 @@ int annotateBoard() {
  * Runs a series of helper functions until all locations on the board are full
  * Once complete, returns 0
  */
-int solve() {
-    annotateBoard();
-    return solveLoop();
+int solve(Board *board) {
+    annotateBoard(board);
+    return solveLoop(board);
 }
 
-int solveLoop() {
-    while(trivialTest() == 0) {             //while empty locations remain:
-        if (!updateAll() && !solveAll()) {  //try to reduce notes and solve cells
-            return guess();
+/*
+ * solveLoop:
+ * - Stops as soon as a conflict is recorded, returning -1
+ *   so that a doomed guess is abandoned straight away
+ */
+int solveLoop(Board *board) {
+    while(!board -> conflict.type && trivialTest(board) == 0) {  //while empty locations remain:
+        if (!updateAll(board) && !solveAll(board)) {            //try to reduce notes and solve cells
+            if (board -> conflict.type) {
+                break;
+            }
+            return guess(board);
         }
-        //printBoard();
+        //printBoard(board);
     }
-    return 0;  //solved without needing to guess
+    return board -> conflict.type ? -1 : 0;  //solved without needing to guess
 }
 
 /*
@@ -302,12 +723,15 @@ int solveLoop() {
  * Used to improve readability
  */
 
-int solveAll() {
+int solveAll(Board *board) {
     int i, check;
+    unsigned long long start = 0;
+    TRACE(start = traceClock());
     check = 0;
-    for (i = 0; i < 27; i++) {
-        check += solveSet(paths[i]);
+    for (i = 0; i < 27 && !board -> conflict.type; i++) {
+        check += solveSet(board, i);
     }
+    TRACE(tracePhase(PhaseSolve, start));
     return check;
 }
 
@@ -319,56 +743,69 @@ int solveAll() {
  * 2. Run secondary solve that checks if there are any notes
  * that only appear in one cell
  * 3. Repeat function if either solve updates a value
+ * 4. Stop early if either solve records a conflict
  */
-int solveSet(Cell *cells[9]) {
+int solveSet(Board *board, int set) {
     int check = 0;
     RESTART:
-    if (singleNoteSolve(cells)) {
+    if (singleNoteSolve(board, set) && !board -> conflict.type) {
         check = 1;
         goto RESTART;
     }
-    if (singleCellSolve(cells)) {
+    if (singleCellSolve(board, set) && !board -> conflict.type) {
         check = 1;
         goto RESTART;
     }
     return check;
 }
 
-int singleNoteSolve(Cell *cells[9]) {
-    int i, n, check;
+/*
+ * singleNoteSolve:
+ * - An empty cell with no notes at all is recorded as a conflict
+ */
+int singleNoteSolve(Board *board, int set) {
+    const unsigned char *cells = units[set];
+    int i, check;
     check = 0;
-    for (i = 0; i < 9; i++) {
-        if (cells[i] -> noteCount == 1) {
-            for (n = 0; n < 9; n++) {
-                if (cells[i] -> notes[n]) {
-                    break;
-                }
-            }
+    for (i = 0; i < 9 && !board -> conflict.type; i++) {
+        if (board -> noteCount[cells[i]] == 1) {
            // printf("SingleSolve\n");
-            assignValue(cells[i], n + 1);
+            assignValue(board, cells[i], firstNote(board -> notes[cells[i]]) + 1,
+                        board -> reasons[cells[i]]);
             check = 1;
+        } else if (board -> noteCount[cells[i]] == 0 && board -> values[cells[i]] == 0) {
+            recordConflict(board, ConflictNoNotes, cells[i], -1, set);
         }
     }
     return check;
 }
 
-int singleCellSolve(Cell *cells[9]) {
-    int n, i, loc, note, count, check;
-    count = check = 0;
-    for (n = 0; n < 9; n++) {
+/*
+ * singleCellSolve:
+ * - A value that is not placed in the set and appears in no cell's notes
+ *   is recorded as a conflict
+ */
+int singleCellSolve(Board *board, int set) {
+    const unsigned char *cells = units[set];
+    int n, i, loc, count, check, placed;
+    count = check = loc = 0;
+    placed = initUpdater(board, set);
+    for (n = 0; n < 9 && !board -> conflict.type; n++) {
         for (i = 0; i < 9; i++) {
-            if (cells[i] -> notes[n]) {
+            if (board -> notes[cells[i]] & (1 << n)) {
                 count++;
                 loc = i;
-                note = n;
                 if (count > 1) {
                     break;
                 }
             }
         }
         if (count == 1) {
-            assignValue(cells[loc], note + 1);
+            assignValue(board, cells[loc], n + 1, setReasons(board, set, AllNotes & ~(1 << loc)));
+            placed |= 1 << n;
             check = 1;
+        } else if (count == 0 && !(placed & (1 << n))) {
+            recordConflict(board, ConflictNoPlace, -1, -1, set);
         }
         count = 0;
     }
@@ -377,14 +814,31 @@ int singleCellSolve(Cell *cells[9]) {
 
 /*
  * assignValue:
- *
+ * - Places val in the cell and clears its notes
+ * - why holds the guesses that forced val (just the current guess when guessing)
+ * - Removes val from the notes of the cell's 20 peers
+ * - Updates the row, column, and square that the cell belongs to
+ * - A peer already holding val is recorded as a conflict
  */
-void assignValue(Cell *cell, int val) {
-    //printCell(cell);
-    cell -> value = val;
-    setEmpty(cell);
-    //printCell(cell);
-    updateCell(cell);
+void assignValue(Board *board, int cell, int val, unsigned long long why) {
+    int i, peer, bit;
+    //printCell(board, cell);
+    bit = 1 << (val - 1);
+    board -> values[cell] = (unsigned char) val;
+    setEmpty(board, cell);
+    board -> reasons[cell] = why;
+    for (i = 0; i < 20; i++) {
+        peer = peers[cell][i];
+        if (board -> notes[peer] & bit) {
+            removeNote(board, peer, val, sharedSet(cell, peer), why);
+        } else if (board -> values[peer] == val) {
+            recordConflict(board, ConflictDuplicate, cell, peer, sharedSet(cell, peer));
+        }
+    }
+    //printCell(board, cell);
+    if (!board -> conflict.type) {
+        updateCell(board, cell);
+    }
 }
 
 /*
@@ -392,12 +846,15 @@ void assignValue(Cell *cell, int val) {
  * - updates all rows, columns, and squares
  */
 
-int updateAll() {
+int updateAll(Board *board) {
     int i, check;
+    unsigned long long start = 0;
+    TRACE(start = traceClock());
     check = 0;
-    for (i = 0; i < 27; i++) {
-        check += updateSet(i);
+    for (i = 0; i < 27 && !board -> conflict.type; i++) {
+        check += updateSet(board, i);
     }
+    TRACE(tracePhase(PhaseUpdate, start));
     return check;
 }
 
@@ -406,120 +863,145 @@ int updateAll() {
  * - Updates the row, column, and square associated with a cell
  * - Used by the solver functions to update the cells surround a solved cell
  */
-void updateCell(Cell *cell) {
-    updateSet(cell -> row);
-    updateSet(cell -> col + 9);
-    updateSet(getSq(cell -> row, cell -> col) + 18);
+void updateCell(Board *board, int cell) {
+    updateSet(board, cellUnits[cell][0]);
+    updateSet(board, cellUnits[cell][1]);
+    updateSet(board, cellUnits[cell][2]);
 }
 
 /*
  *
  */
-int updateSet(int set) {
-    if (singleCheck(paths[set])) {
+int updateSet(Board *board, int set) {
+    if (singleCheck(board, set)) {
         return 1;
     }
-    if (groupCheck(paths[set])) {
+    if (groupCheck(board, set)) {
         return 1;
     }
     return 0;
 }
 
-int singleCheck(Cell *cells[9]) {
-    int updater[9] = {1, 1, 1, 1, 1, 1, 1, 1, 1};
-    initUpdater(cells, updater);
-    return clearConflicts(cells, updater);
+int singleCheck(Board *board, int set) {
+    return clearConflicts(board, set, initUpdater(board, set));
 }
 
-void initUpdater(Cell *cells[9], int updater[9]) {
-    int i;
+/*
+ * initUpdater:
+ * - Returns a bitmask of every value already placed in the set
+ * - A value placed twice is recorded as a conflict
+ */
+int initUpdater(Board *board, int set) {
+    const unsigned char *cells = units[set];
+    int i, n, bit, updater;
+    updater = 0;
     for (i = 0; i < 9; i++) {
-        if (cells[i] -> value != 0) {
-            updater[cells[i] -> value - 1] = 0;
+        if (board -> values[cells[i]] != 0) {
+            bit = 1 << (board -> values[cells[i]] - 1);
+            if (updater & bit) {
+                for (n = 0; board -> values[cells[n]] != board -> values[cells[i]]; n++);
+                recordConflict(board, ConflictDuplicate, cells[i], cells[n], set);
+            }
+            updater |= bit;
         }
     }
+    return updater;
 }
 
-int clearConflicts(Cell *cells[9], const int updater[9]) {
-    int i, n;
+/*
+ * clearConflicts:
+ * - Removes the values placed in the set (updater) from the notes of its empty cells
+ * - Each removal depends on whatever the cell holding the removed value depends on
+ */
+int clearConflicts(Board *board, int set, int updater) {
+    const unsigned char *cells = units[set];
+    int i, n, cleared, holders;
     int check = 0;
     for (i = 0; i < 9; i++) {
-        if (cells[i] -> value == 0) {
-            for (n = 0; n < 9; n++) {
-                if (updater[n] == 0 && cells[i] -> notes[n] == 1) {
-                    //printCell(cells[i]);
-                    cells[i] -> notes[n] = 0;
-                    cells[i] -> noteCount -= 1;
-                    check = 1;
-                    //printCell(cells[i]);
+        if (board -> values[cells[i]] == 0) {
+            cleared = board -> notes[cells[i]] & updater;
+            if (cleared) {
+                //printCell(board, cells[i]);
+                holders = 0;
+                for (n = 0; n < 9; n++) {
+                    if (board -> values[cells[n]] && (cleared & (1 << (board -> values[cells[n]] - 1)))) {
+                        holders |= 1 << n;
+                    }
+                }
+                board -> notes[cells[i]] &= ~cleared;
+                board -> noteCount[cells[i]] -= countNotes(cleared);
+                board -> reasons[cells[i]] |= setReasons(board, set, holders);
+                check = 1;
+                if (board -> noteCount[cells[i]] == 0) {
+                    recordConflict(board, ConflictNoNotes, cells[i], -1, set);
                 }
+                //printCell(board, cells[i]);
             }
         }
     }
     return check;
 }
 
-int groupCheck(Cell *cells[9]) {
-    int i, n, count, check;
+/*
+ * groupCheck:
+ * - Looks for n cells in the set that share the same n notes
+ * - Those notes can then be removed from every other cell in the set
+ * - members is a bitmask of the positions (0-8) in the set that form the group
+ */
+int groupCheck(Board *board, int set) {
+    const unsigned char *cells = units[set];
+    int i, n, count, members, noteCount, check;
     check = 0;
-    count = 1;
     for (i = 0; i < 9; i++) {
-        if (cells[i] -> noteCount > 1) {
-            int *indices = (int*) malloc(cells[i] -> noteCount * sizeof(int));
-            indices[0] = i;
+        noteCount = board -> noteCount[cells[i]];
+        if (noteCount > 1) {
+            count = 1;
+            members = 1 << i;
             for (n = i + 1; n < 9; n++) {
-                if(cells[i] -> noteCount == cells[n] -> noteCount &&
-                   equalsArr(cells[i] -> notes, cells[n] -> notes, 9)) {
-                    indices[count] = n;
+                if (board -> notes[cells[i]] == board -> notes[cells[n]]) {
+                    members |= 1 << n;
                     count++;
                 }
-                if (count == cells[i] -> noteCount) {
-                    check += groupCancel(cells, indices, cells[i] -> noteCount);
+                if (count == noteCount) {
+                    check += groupCancel(board, set, members, board -> notes[cells[i]]);
+                    break;
                 }
-                if ((9 - n) < (cells[i] -> noteCount - count)) {
+                if ((9 - n) < (noteCount - count)) {
                     break;
                 }
             }
-            count = 1;
-            free(indices);
         }
     }
     return check;
 }
 
-int groupCancel(Cell *cells[9], int *indices, int noteCount) {
-    //create an array noteValues that stores all of the groups note values
-    int *noteValues = (int*) malloc(noteCount * sizeof(int));
-    int i, n, count, sum, check;
-    count = sum = check = 0;
-    for (i = 0; i < 9; i++) {
-        if (cells[indices[0]] -> notes[i]) {
-            noteValues[count] = i;
-            count++;
-        }
-    }
+int groupCancel(Board *board, int set, int members, int group) {
+    const unsigned char *cells = units[set];
+    int i, cleared, check;
+    check = 0;
     /*
-     * For cells that are not filled nor contained in the indices array:
-     * - Set each note value stored in noteValues to zero.
-     * - Use the "sum" variable to track if any values have been updated.
-     * - Sum is used by the main update method to determine whether it has
+     * For cells that are not filled nor contained in the group:
+     * - Clear each note value stored in group.
+     * - Use the "check" variable to track if any values have been updated.
+     * - Check is used by the main update method to determine whether it has
      *   completed, or if it should run a more complex update algorithm.
+     * - A cell left without notes (e.g. more cells share the group's notes
+     *   than there are notes) is recorded as a conflict.
      */
     for (i = 0; i < 9; i++) {
-        if (cells[i] -> value == 0 &&
-            !inArray(i, indices, noteCount)) {
-            for (n = 0; n < noteCount; n++) {
-                sum += cells[i] -> notes[noteValues[n]];
-                cells[i] -> notes[noteValues[n]] = 0;
-            }
-            cells[i] -> noteCount -= sum;
-            if (sum != 0) {
+        if (board -> values[cells[i]] == 0 && !(members & (1 << i))) {
+            cleared = board -> notes[cells[i]] & group;
+            if (cleared) {
+                board -> notes[cells[i]] &= ~cleared;
+                board -> noteCount[cells[i]] -= countNotes(cleared);
+                board -> reasons[cells[i]] |= setReasons(board, set, members);
                 check = 1;
+                if (board -> noteCount[cells[i]] == 0) {
+                    recordConflict(board, ConflictNoNotes, cells[i], -1, set);
+                }
             }
-            sum = 0;
         }
     }
-    free(noteValues);
     return check;
 }
 
@@ -532,186 +1014,258 @@ int groupCancel(Cell *cells[9], int *indices, int noteCount) {
  * - Used to solve the board when all other solve functions are unsuccessful
  * Description:
  * 1. Copy the current board so that the guess can be reversed if incorrect
- * 2. Select a cell with the minimum amount of possible numbers (reduces guessing)
- * 3. For each possible guess, update the cell with the guessed value and reenter
- * the solve loop.
+ * 2. Select a cell with the minimum amount of possible numbers (reduces guessing),
+ *    preferring cells in sets where earlier guesses ran into conflicts
+ * 3. Try the cell's lowest possible number and reenter the solve loop.
  *      - If the solve loop finds the solution, it will return a zero and break out of the guess function
- *      - If a solution is not found for a particular guess, the board is reset and the next guess is attempted
- *      - If no guess is viable, the funtion returns a -1. This usually happens if a prior guess was incorrect
+ *      - If the guess leads to a conflict, the board is reset and the number is removed from
+ *        the cell's notes. The solve loop then continues from the reset board, so the removal
+ *        is propagated and no later guess can repeat the same conflict.
+ *      - If the conflict's reasons do not include this guess, it would happen whichever number
+ *        went in the cell, so the remaining numbers are skipped and the conflict is passed
+ *        straight back to the guess it does depend on (backjumping)
+ *      - If the removal leaves the board in conflict, the funtion returns a -1. This usually
+ *        happens if a prior guess was incorrect
  *      - Guess may be called recursively, if the board reaches another point where solve methods are unsuccessful
  */
-int guess() {
-    int i, solveVal;
-    Cell boardCopy[9][9];
-    copyBoard(board, boardCopy);
-    Cell *cellGuess = bestGuess();
-    for (i = 0; i < 9; i++) {
-        if (cellGuess -> notes[i]) {
-            guesses++;
-            assignValue(cellGuess, i + 1);
-            //printBoard();
-            solveVal = solveLoop();
-            if (solveVal == 0) {
-                return 0;
-            }
-            copyBoard(boardCopy, board);
-        }
+int guess(Board *board) {
+    int cell, notes, val;
+    unsigned long long bit, why;
+    Board boardCopy;
+    cell = bestGuess(board);
+    notes = board -> notes[cell];
+    if (notes == 0) {
+        recordConflict(board, ConflictNoNotes, cell, -1, cellUnits[cell][0]);
+        return -1;
+    }
+    val = firstNote(notes) + 1;
+    copyBoard(board, &boardCopy);
+    TRACE(traceBranch(cell, notes));
+
+    board -> guesses++;
+    board -> depth++;
+    bit = depthBit(board -> depth);
+    TRACE(traceGuess(cell, val));
+    assignValue(board, cell, val, bit);
+    //printBoard(board);
+    if (solveLoop(board) == 0) {
+        board -> depth--;
+        TRACE(traceLeave());
+        return 0;
+    }
+    why = board -> conflict.reasons;
+    board -> setConflicts[board -> conflict.set]++;
+    TRACE(traceBacktrack(cell, val));
+    TRACE(traceLeave());
+    if (!(why & bit)) {
+        board -> depth--;
+        return -1;
     }
-    return -1;
+    if (board -> depth < ReasonBits - 1) {
+        why &= ~bit;   //the deepest bit is shared by every deeper guess, so it is kept
+    }
+    board -> depth--;
+    copyBoard(&boardCopy, board);
+
+    removeNote(board, cell, val, cellUnits[cell][0], why);
+    return solveLoop(board);
 }
 
 /*
  * bestGuess:
- * - Returns a pointer to the Cell bst suited for guessing
- * - The best Cell is one that has as few possible values as possible
+ * - Returns the index of the cell best suited for guessing
+ * - The best cell is one that has as few possible values as possible
+ * - Ties go to the cell whose sets have ended the most guesses in conflict,
+ *   so the search branches where earlier guesses kept failing
  */
-Cell *bestGuess() {
-    int r, c, row, col, minNotes;
+int bestGuess(Board *board) {
+    int i, best, minNotes, weight, maxWeight;
     minNotes = 10;
-    for (r = 0; r < Rows; r++) {
-        for (c = 0; c < Columns; c++) {
-            if(board[r][c].value == 0 && board[r][c].noteCount < minNotes) {
-                minNotes = board[r][c].noteCount;
-                row = r;
-                col = c;
-            }
-            if (minNotes == 2) {
-                break;
-            }
+    maxWeight = -1;
+    best = 0;
+    for (i = 0; i < BoardSize; i++) {
+        if (board -> values[i] != 0 || board -> noteCount[i] > minNotes) {
+            continue;
+        }
+        weight = board -> setConflicts[cellUnits[i][0]] +
+                 board -> setConflicts[cellUnits[i][1]] +
+                 board -> setConflicts[cellUnits[i][2]];
+        if (board -> noteCount[i] < minNotes || weight > maxWeight) {
+            minNotes = board -> noteCount[i];
+            maxWeight = weight;
+            best = i;
         }
     }
-    return &board[row][col];
+    return best;
 }
 
 /*
- * Get Position Methods
+ * Notes Initialize/Clear Functions
  */
 
 /*
- * getRow:
- * Returns the row of the cell associated with a certain square and position
+ * setEmpty:
+ * - Clears every note of the specified cell
+ * - Sets the noteCount to zero
  */
-int getRow(int square, int pos) {
-    return 3 * (square / 3) + (pos / 3);
+void setEmpty(Board *board, int cell) {
+    board -> notes[cell] = 0;
+    board -> noteCount[cell] = 0;
 }
 
 /*
- * getCol:
- * Returns the column of the cell associated with a certain square and position
+ * setFull:
+ * - Sets every note of the specified cell
+ * - Sets the noteCount to 9 (filled completely)
  */
-int getCol(int square, int pos) {
-    return 3 * (square % 3) + (pos % 3);
+void setFull(Board *board, int cell) {
+    board -> notes[cell] = AllNotes;
+    board -> noteCount[cell] = 9;
 }
 
 /*
- * getSq:
- * Returns the value of the square the cell is located in given the row and column
+ * removeNote:
+ * - Removes val from the notes of an empty cell, because of the guesses in why
+ * - A cell left without notes is recorded as a conflict in set
  */
-int getSq(int row, int col) {
-    return 3 * (row / 3) + (col / 3);
+void removeNote(Board *board, int cell, int val, int set, unsigned long long why) {
+    board -> notes[cell] &= ~(1 << (val - 1));
+    board -> noteCount[cell] -= 1;
+    board -> reasons[cell] |= why;
+    if (board -> noteCount[cell] == 0) {
+        recordConflict(board, ConflictNoNotes, cell, -1, set);
+    }
 }
 
 /*
- * Notes Initialize/Clear Functions
+ * Conflict Functions
  */
 
 /*
- * setEmpty:
- * - Sets the note array of the specified cell to all zeroes
- * - Sets the noteCount to zero
+ * recordConflict:
+ * - Stores a contradiction on the board, unless one is already stored
+ * - Only the first conflict is kept, since it is the one that stopped the solver
  */
-void setEmpty(Cell *cell) {
-    int i;
-    for (i = 0; i < 9; i++) {
-        cell -> notes[i] = 0;
+void recordConflict(Board *board, int type, int cell, int other, int set) {
+    if (board -> conflict.type == ConflictNone) {
+        board -> conflict.type = type;
+        board -> conflict.cell = cell;
+        board -> conflict.other = other;
+        board -> conflict.set = set;
+        board -> conflict.reasons = conflictReasons(board);
+    }
+}
+
+void clearConflict(Board *board) {
+    board -> conflict.type = ConflictNone;
+    board -> conflict.cell = -1;
+    board -> conflict.other = -1;
+    board -> conflict.set = -1;
+    board -> conflict.reasons = 0;
+}
+
+/*
+ * conflictReasons:
+ * - Returns the guesses that the stored conflict depends on
+ * - Only the cells the conflict names are involved: the empty cell for
+ *   ConflictNoNotes, both cells for ConflictDuplicate, and every cell of
+ *   the set for ConflictNoPlace
+ */
+unsigned long long conflictReasons(Board *board) {
+    switch (board -> conflict.type) {
+        case ConflictNoNotes:
+            return board -> reasons[board -> conflict.cell];
+        case ConflictDuplicate:
+            return board -> reasons[board -> conflict.cell] | board -> reasons[board -> conflict.other];
+        case ConflictNoPlace:
+            return setReasons(board, board -> conflict.set, AllNotes);
+        default:
+            return 0;
     }
-    cell -> noteCount = 0;
 }
 
 /*
- * setFull:
- * - Sets the note array of the specified cell to all ones
- * - Sets the noteCount to 9 (filled completely)
+ * setReasons:
+ * - Returns the combined reasons of the cells of a set whose positions (0-8)
+ *   are in the members bitmask
  */
-void setFull(Cell *cell) {
+unsigned long long setReasons(Board *board, int set, int members) {
+    unsigned long long why = 0;
     int i;
     for (i = 0; i < 9; i++) {
-        cell -> notes[i] = 1;
+        if (members & (1 << i)) {
+            why |= board -> reasons[units[set][i]];
+        }
     }
-    cell -> noteCount = 9;
+    return why;
 }
 
 /*
- * Array Helper Functions
+ * depthBit:
+ * - Returns the reason bit of the guess made at depth (1 or deeper)
+ * - Guesses deeper than ReasonBits - 1 all share the last bit
  */
+unsigned long long depthBit(int depth) {
+    return 1ULL << (depth < ReasonBits - 1 ? depth : ReasonBits - 1);
+}
 
 /*
- * equalsArr: Checks if the data in arr1 is the same as arr2.
- * Assumes that arr1 and arr2 are integer arrays of equal length.
- * Returns 1 if equal, and 0 if not.
+ * sharedSet: Returns the first set that two peer cells both belong to
  */
-int equalsArr(const int *arr1, const int *arr2, int length) {
-    int i;
-    for (i = 0; i < length; i++) {
-        if (arr1[i] != arr2[i]) {
-            return 0;
+int sharedSet(int cell, int other) {
+    int s;
+    for (s = 0; s < 2; s++) {
+        if (cellUnits[cell][s] == cellUnits[other][s]) {
+            break;
         }
     }
-    return 1;
+    return cellUnits[cell][s];
 }
 
 /*
- * inArray: Searches for a specified number in an array of known length (linear search)
- * Returns 1 if the number appears in the array, and 0 if not.
+ * Note Helper Functions
  */
-int inArray(int num, const int *arr, int length) {
-    int i;
-    for (i = 0; i < length; i++) {
-        if (num == arr[i]) {
-            return 1;
-        }
-    }
-    return 0;
-}
 
 /*
- * Copy Functions:
- * Used during the guess() function to save the current board before making a guess
+ * countNotes: Returns how many notes are set in a note bitmask
  */
+int countNotes(int notes) {
+    int count = 0;
+    while (notes) {
+        notes &= notes - 1;
+        count++;
+    }
+    return count;
+}
 
 /*
- * copyBoard: Copies the cells from mainBoard to boardCopy
- * - note that the cells of boardCopy are distinct from mainBoard, they are NOT pointers
- * to mainBoard
+ * firstNote: Returns the index (0-8) of the lowest note set in a note bitmask
+ * Returns 9 if no notes are set.
  */
-void copyBoard(Cell mainBoard[9][9], Cell boardCopy[9][9]) {
-    int r, c;
-    for (r = 0; r < Rows; r++) {
-        for (c = 0; c < Columns; c++) {
-            copyCell(&mainBoard[r][c], &boardCopy[r][c]);
+int firstNote(int notes) {
+    int n;
+    for (n = 0; n < 9; n++) {
+        if (notes & (1 << n)) {
+            break;
         }
     }
+    return n;
 }
 
 /*
- * copyCell: copies the data from one cell to another.
- * Used by the copyBoard function
+ * Copy Functions:
+ * Used during the guess() function to save the current board before making a guess
  */
-void copyCell(Cell *import, Cell *export) {
-    export -> value = import -> value;
-    export -> row = import -> row;
-    export -> col = import -> col;
-    export -> noteCount = import -> noteCount;
-    copyArr(import -> notes, export -> notes, 9);
-}
 
 /*
- * copyArr: copies the data from one integer array to another of the same size.
- * Used by the copyCell function to copy notes from one cell to another
+ * copyBoard: Copies the cell data and conflict from mainBoard to boardCopy
+ * - The guess counter, depth, and set conflict counts are left alone, so restoring
+ *   a saved board does not undo what was learned from the guesses already made
  */
-void copyArr(int *import, int *export, int size) {
-    int i;
-    for (i = 0; i < size; i++) {
-        export[i] = import[i];
-    }
-}
\ No newline at end of file
+void copyBoard(Board *mainBoard, Board *boardCopy) {
+    memcpy(boardCopy -> values, mainBoard -> values, sizeof(mainBoard -> values));
+    memcpy(boardCopy -> notes, mainBoard -> notes, sizeof(mainBoard -> notes));
+    memcpy(boardCopy -> noteCount, mainBoard -> noteCount, sizeof(mainBoard -> noteCount));
+    memcpy(boardCopy -> reasons, mainBoard -> reasons, sizeof(mainBoard -> reasons));
+    boardCopy -> conflict = mainBoard -> conflict;
+}
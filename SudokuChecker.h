@@ -10,82 +10,135 @@
 #define Squares 9
 #define BoardSize 81
 
-typedef struct Cell Cell;
+#define AllNotes 0x1FF
 
 /*
- * Cell struct:
- * - value -> stores the 1-9 value visible on the sudoku board (0 if empty)
- * - row -> the row which the cell is located in (0-8)
- * - col -> the column which the cell is located in (0-8)
- * - noteCount -> If the cell's value is unknown (0), noteCount
- *   measures how many numbers could be placed in that location
- * - notes -> Array of size 9 that stores either a 1 or 0 in each location
- *   to keep track of what numbers could viably go in the cell. Note that
- *   the values are equal to the index in the array + 1, because the
- *   indices go from 0 to 8.
+ * Conflict types
  */
-struct Cell {
-    int value;
-    int row;
-    int col;
-    int noteCount;
-    int notes[9];
+#define ConflictNone 0
+#define ConflictNoNotes 1      //an empty cell has no notes left
+#define ConflictDuplicate 2    //a value is placed twice in one set
+#define ConflictNoPlace 3      //a value has no cell left in a set
+
+#define ReasonBits 64          //guess depths tracked apart in a reason mask (see depthBit)
+
+typedef struct Conflict Conflict;
+typedef struct Board Board;
+typedef struct Reader Reader;    //see SudokuPack.h
+
+/*
+ * Conflict struct:
+ * The first contradiction found on a board, which makes the current guess impossible
+ * - type -> one of the Conflict* values above
+ * - cell -> index of the cell involved (-1 if none)
+ * - other -> index of the second cell holding the same value (duplicates only, else -1)
+ * - set -> the set (0-26) the contradiction was found in
+ * - reasons -> the guesses the contradiction depends on (see conflictReasons)
+ */
+struct Conflict {
+    int type;
+    int cell;
+    int other;
+    int set;
+    unsigned long long reasons;
+};
+
+/*
+ * Board struct:
+ * Stored as flat arrays indexed by cell (index = 9 * row + col), so that
+ * the solver walks contiguous memory using the tables in SudokuTables.h
+ * - values -> the 1-9 value visible on the sudoku board (0 if empty)
+ * - notes -> If the cell's value is unknown (0), bit n is set when
+ *   n + 1 could viably go in the cell
+ * - noteCount -> how many bits are set in notes
+ * - reasons -> bit d is set when the cell's value or notes depend on the guess
+ *   made at depth d (see depthBit); 0 for anything that follows from the puzzle alone
+ * - guesses -> how many guesses the solver made on this board
+ * - depth -> how many guesses deep the solver currently is
+ * - setConflicts -> how many failed guesses ended in a conflict in each set
+ * - conflict -> the contradiction that stopped the solver, if any
+ */
+struct Board {
+    unsigned char values[BoardSize];
+    unsigned short notes[BoardSize];
+    unsigned char noteCount[BoardSize];
+    unsigned long long reasons[BoardSize];
+    int guesses;
+    int depth;
+    int setConflicts[27];
+    Conflict conflict;
 };
 
 /*
  * Function Headers
  */
 
-int initBoard(FILE *file);    //loader functions
-void outputBoard(FILE *file);
-void definePaths();
+int initBoard(Board *board, FILE *file);    //loader functions
+int readBoard(Board *board, FILE *file);
+int gridRow(const char *line);
+void outputBoard(Board *board, FILE *file);
+void writeBoard(Board *board, FILE *file);
+void writePuzzle(Board *board, FILE *file);
+void openInput(Reader *reader, int argc, char *argv[]);
+int nextBoards(Reader *reader, Board *boards, int max);
+FILE *openOutput(int argc, char *argv[], const char *mode);
 void usage(char *arg);
 
-int testBoard();    //completion test functions
-int trivialTest();
-int setTest();
+int modeMain(int argc, char *argv[]);    //multi-puzzle modes
+int batchMain(int argc, char *argv[]);
+int packMain(int argc, char *argv[], int withSolutions);
+int unpackMain(int argc, char *argv[]);
+int benchMain(int argc, char *argv[]);
+int traceMain(int argc, char *argv[], int binary);
+int sessionMain(int argc, char *argv[]);
+
+int testBoard(Board *board);    //completion test functions
+int trivialTest(Board *board);
+int setTest(Board *board);
 
-void printBoard();  //debugging/printer functions
-void printCell(struct Cell *cell);
+void printBoard(Board *board);  //debugging/printer functions
+void printCell(Board *board, int cell);
 
-int annotateBoard(); //solver functions
-int solve();
-int solveLoop();
+int annotateBoard(Board *board); //solver functions
+int solve(Board *board);
+int solveLoop(Board *board);
 
-int solveAll();
+int solveAll(Board *board);
 
-int solveSet(struct Cell *cells[9]);
-int singleNoteSolve(struct Cell *cells[9]);
-int singleCellSolve(struct Cell *cells[9]);
+int solveSet(Board *board, int set);
+int singleNoteSolve(Board *board, int set);
+int singleCellSolve(Board *board, int set);
 
-void assignValue(struct Cell *cell, int val);
+void assignValue(Board *board, int cell, int val, unsigned long long why);
 
-void setEmpty(struct Cell *cell);  //initialize and delete cell note values
-void setFull(struct Cell *cell);
+void setEmpty(Board *board, int cell);  //initialize and delete cell note values
+void setFull(Board *board, int cell);
 
-int updateAll();
+int updateAll(Board *board);
 
-void updateCell(struct Cell *cell);
+void updateCell(Board *board, int cell);
 
-int updateSet(int set);
-int singleCheck(struct Cell *cells[9]);
-void initUpdater(struct Cell *cells[9], int updater[9]);
-int clearConflicts(struct Cell *cells[9], const int updater[9]);
-int groupCheck(struct Cell *cells[9]);
-int groupCancel(struct Cell *cells[9], int *indices, int noteCount);
+int updateSet(Board *board, int set);
+int singleCheck(Board *board, int set);
+int initUpdater(Board *board, int set);
+int clearConflicts(Board *board, int set, int updater);
+int groupCheck(Board *board, int set);
+int groupCancel(Board *board, int set, int members, int group);
 
+void recordConflict(Board *board, int type, int cell, int other, int set);
+void clearConflict(Board *board);
+unsigned long long conflictReasons(Board *board);
+unsigned long long setReasons(Board *board, int set, int members);
+unsigned long long depthBit(int depth);
+int sharedSet(int cell, int other);
+void removeNote(Board *board, int cell, int val, int set, unsigned long long why);
 
-int getRow(int square, int pos);    //math expressions to convert between (row, col) coords
-int getCol(int square, int pos);    //to (square, pos) coords
-int getSq(int row, int col);        //(row, col) coords are used whenever possible
-int equalsArr(const int *arr1, const int *arr2, int maxLength);
-int inArray(int num, const int *arr, int length);
+int countNotes(int notes);    //note bitmask helpers
+int firstNote(int notes);
 
-int guess();
-struct Cell *bestGuess();
+int guess(Board *board);
+int bestGuess(Board *board);
 
-void copyBoard(struct Cell mainBoard[9][9], struct Cell boardCopy[9][9]);
-void copyArr(int *import, int *export, int size);
-void copyCell(struct Cell *import, struct Cell *export);
+void copyBoard(Board *mainBoard, Board *boardCopy);
 
 #endif //SUDOKU_SUDOKUCHECKER_H
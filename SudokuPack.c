@@ -0,0 +1,385 @@
+/*
+ * SudokuPack:
+ * Reads and writes the packed binary puzzle format described in SudokuPack.h.
+ * Packed files are mapped into memory, so any puzzle can be read directly
+ * through the offset index without parsing the rest of the file.
+ *
+ * Created on 10/18/26.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "SudokuPack.h"
+
+/*
+ * isPackFile:
+ * - Returns 1 if the file starts with the packed format magic, 0 otherwise
+ */
+int isPackFile(const char *path) {
+    char magic[4];
+    FILE *file = fopen(path, "rb");
+    int check = 0;
+    if (file) {
+        check = fread(magic, 1, 4, file) == 4 && memcmp(magic, PackMagic, 4) == 0;
+        fclose(file);
+    }
+    return check;
+}
+
+/*
+ * packOpen:
+ * - Maps a packed file into memory and checks its header and index bounds
+ * - Returns -1 if the file cannot be mapped or is not a valid packed file
+ */
+int packOpen(Pack *pack, const char *path) {
+    int fd;
+    struct stat info;
+    unsigned long long indexOffset, solutionOffset;
+    const unsigned char *data;
+
+    memset(pack, 0, sizeof(Pack));
+    fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+    if (fstat(fd, &info) == -1 || info.st_size < PackHeaderSize) {
+        close(fd);
+        return -1;
+    }
+    data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return -1;
+    }
+    pack -> data = data;
+    pack -> size = info.st_size;
+
+    if (memcmp(data, PackMagic, 4) != 0 ||
+        readU16(data + 4) != PackVersion ||
+        readU32(data + 12) != PackRecordSize) {
+        packClose(pack);
+        return -1;   //error: not a packed file, or a newer version
+    }
+    pack -> flags = readU16(data + 6);
+    pack -> count = (int) readU32(data + 8);
+    indexOffset = readU64(data + 16);
+    solutionOffset = readU64(data + 24);
+
+    if (indexOffset > pack -> size ||
+        (pack -> size - indexOffset) / 8 < (unsigned long long) pack -> count) {
+        packClose(pack);
+        return -1;   //error: index runs past the end of the file
+    }
+    pack -> index = data + indexOffset;
+
+    if (pack -> flags & PackSolutions) {
+        if (solutionOffset > pack -> size ||
+            (pack -> size - solutionOffset) / PackRecordSize < (unsigned long long) pack -> count) {
+            packClose(pack);
+            return -1;   //error: solutions run past the end of the file
+        }
+        pack -> solutions = data + solutionOffset;
+    }
+    return 0;
+}
+
+void packClose(Pack *pack) {
+    if (pack -> data) {
+        munmap((void *) pack -> data, pack -> size);
+    }
+    memset(pack, 0, sizeof(Pack));
+}
+
+/*
+ * packBoard:
+ * - Loads puzzle number index into board, ready for solve()
+ * - Returns -1 if the index or its record is out of range
+ */
+int packBoard(Pack *pack, int index, Board *board) {
+    unsigned long long offset;
+    if (index < 0 || index >= pack -> count) {
+        return -1;
+    }
+    offset = readU64(pack -> index + 8 * (size_t) index);
+    if (offset > pack -> size || pack -> size - offset < PackRecordSize) {
+        return -1;
+    }
+    unpackRecord(pack -> data + offset, board);
+    return 0;
+}
+
+/*
+ * packSolution:
+ * - Loads the stored solution of puzzle number index into board
+ * - Returns -1 if the index is out of range or the file has no solutions,
+ *   1 if the puzzle was stored as having no solution
+ */
+int packSolution(Pack *pack, int index, Board *board) {
+    const unsigned char *record;
+    if (!pack -> solutions || index < 0 || index >= pack -> count) {
+        return -1;
+    }
+    record = pack -> solutions + PackRecordSize * (size_t) index;
+    unpackRecord(record, board);
+    return (record[0] & 0xF) == PackNoSolution;
+}
+
+/*
+ * Writer Functions:
+ * Write a packed file from puzzles added one at a time
+ */
+
+/*
+ * writerOpen:
+ * - Starts a packed file, with a solution section if withSolutions is set
+ * - Returns -1 if the temporary files cannot be created
+ */
+int writerOpen(Writer *writer, FILE *file, int withSolutions) {
+    memset(writer, 0, sizeof(Writer));
+    writer -> file = file;
+    writer -> puzzles = tmpfile();
+    if (withSolutions) {
+        writer -> solutions = tmpfile();
+    }
+    if (!writer -> puzzles || (withSolutions && !writer -> solutions)) {
+        writerClose(writer);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * writerAdd:
+ * - Adds a puzzle and, if the file has a solution section, its solution
+ * - A NULL solution is stored as the PackNoSolution record
+ * - Returns -1 if the records could not be written
+ */
+int writerAdd(Writer *writer, Board *puzzle, Board *solution) {
+    unsigned char record[PackRecordSize];
+    packRecord(puzzle, record);
+    fwrite(record, 1, PackRecordSize, writer -> puzzles);
+    if (writer -> solutions) {
+        if (solution) {
+            packRecord(solution, record);
+        } else {
+            memset(record, PackNoSolution | (PackNoSolution << 4), PackRecordSize);
+        }
+        fwrite(record, 1, PackRecordSize, writer -> solutions);
+    }
+    writer -> count++;
+    return ferror(writer -> puzzles) || (writer -> solutions && ferror(writer -> solutions)) ? -1 : 0;
+}
+
+/*
+ * writerClose:
+ * - Writes the header and index, then copies the records in after them
+ * - The temporary files are removed, but the packed file is left open
+ * - Returns -1 if the file could not be written
+ */
+int writerClose(Writer *writer) {
+    int i, check;
+    unsigned char header[PackHeaderSize], bytes[8];
+    unsigned long long indexOffset, puzzleOffset, solutionOffset;
+
+    check = writer -> puzzles ? 0 : -1;
+    if (check == 0) {
+        indexOffset = PackHeaderSize;
+        puzzleOffset = indexOffset + 8 * (unsigned long long) writer -> count;
+        solutionOffset = writer -> solutions ? puzzleOffset + PackRecordSize * (unsigned long long) writer -> count : 0;
+
+        memset(header, 0, sizeof(header));
+        memcpy(header, PackMagic, 4);
+        writeU16(header + 4, PackVersion);
+        writeU16(header + 6, writer -> solutions ? PackSolutions : 0);
+        writeU32(header + 8, (unsigned int) writer -> count);
+        writeU32(header + 12, PackRecordSize);
+        writeU64(header + 16, indexOffset);
+        writeU64(header + 24, solutionOffset);
+        fwrite(header, 1, sizeof(header), writer -> file);
+
+        for (i = 0; i < writer -> count; i++) {
+            writeU64(bytes, puzzleOffset + PackRecordSize * (unsigned long long) i);
+            fwrite(bytes, 1, 8, writer -> file);
+        }
+        check = copyFile(writer -> puzzles, writer -> file);
+        if (check == 0 && writer -> solutions) {
+            check = copyFile(writer -> solutions, writer -> file);
+        }
+        if (ferror(writer -> file)) {
+            check = -1;
+        }
+    }
+    if (writer -> puzzles) {
+        fclose(writer -> puzzles);
+    }
+    if (writer -> solutions) {
+        fclose(writer -> solutions);
+    }
+    writer -> puzzles = writer -> solutions = NULL;
+    return check;
+}
+
+/*
+ * copyFile:
+ * - Copies everything written to the temporary file from onto the end of to
+ * - Returns -1 if either file fails
+ */
+int copyFile(FILE *from, FILE *to) {
+    unsigned char buffer[4096];
+    size_t n;
+    if (fflush(from) != 0 || fseek(from, 0, SEEK_SET) != 0) {
+        return -1;
+    }
+    while ((n = fread(buffer, 1, sizeof(buffer), from)) > 0) {
+        if (fwrite(buffer, 1, n, to) != n) {
+            return -1;
+        }
+    }
+    return ferror(from) ? -1 : 0;
+}
+
+/*
+ * Reader Functions:
+ * Read puzzles from a text or packed file in order, a few at a time
+ */
+
+/*
+ * readerOpen:
+ * - Opens a text or packed file to read count puzzles, starting from
+ *   puzzle number first (count -1 reads every puzzle after first)
+ * - Packed puzzles before first are passed over through the index,
+ *   text puzzles are parsed and skipped
+ * - Returns -1 if the file cannot be opened, is not a valid packed file,
+ *   or holds a malformed puzzle before first
+ */
+int readerOpen(Reader *reader, const char *path, int first, int count) {
+    Board skipped;
+    int status;
+    memset(reader, 0, sizeof(Reader));
+    if (isPackFile(path)) {
+        if (packOpen(&reader -> pack, path) == -1) {
+            return -1;
+        }
+        reader -> next = first < reader -> pack.count ? first : reader -> pack.count;
+        reader -> end = reader -> pack.count;
+        if (count >= 0 && count < reader -> end - reader -> next) {
+            reader -> end = reader -> next + count;
+        }
+        return 0;
+    }
+
+    reader -> file = fopen(path, "r");
+    if (!reader -> file) {
+        return -1;
+    }
+    reader -> end = count >= 0 ? first + count : -1;
+    while (reader -> next < first) {
+        status = readBoard(&skipped, reader -> file);
+        if (status == -1) {
+            readerClose(reader);
+            return -1;
+        }
+        if (status == 1) {
+            break;   //the file holds fewer than first puzzles
+        }
+        reader -> next++;
+    }
+    return 0;
+}
+
+/*
+ * readerNext:
+ * - Loads up to max of the next puzzles into boards, ready for solve()
+ * - Packed puzzles are decoded straight from the mapped file
+ * - Returns how many puzzles were loaded (0 once there are none left),
+ *   or -1 if puzzle number next is malformed
+ */
+int readerNext(Reader *reader, Board *boards, int max) {
+    int n, status;
+    for (n = 0; n < max && (reader -> end == -1 || reader -> next < reader -> end); n++) {
+        if (reader -> file) {
+            status = readBoard(&boards[n], reader -> file);
+        } else {
+            status = packBoard(&reader -> pack, reader -> next, &boards[n]);
+        }
+        if (status == -1) {
+            return -1;
+        }
+        if (status == 1) {
+            break;   //end of a text file
+        }
+        reader -> next++;
+    }
+    return n;
+}
+
+void readerClose(Reader *reader) {
+    if (reader -> file) {
+        fclose(reader -> file);
+        reader -> file = NULL;
+    }
+    packClose(&reader -> pack);
+}
+
+/*
+ * Record Functions:
+ * Convert between board values and 4-bit packed records
+ */
+
+void packRecord(Board *board, unsigned char record[PackRecordSize]) {
+    int i;
+    memset(record, 0, PackRecordSize);
+    for (i = 0; i < BoardSize; i++) {
+        record[i / 2] |= (unsigned char) (board -> values[i] << (4 * (i % 2)));
+    }
+}
+
+/*
+ * unpackRecord:
+ * - Out of range cells (10-15) are loaded as empty
+ */
+void unpackRecord(const unsigned char *record, Board *board) {
+    int i, val;
+    board -> guesses = 0;
+    clearConflict(board);
+    for (i = 0; i < BoardSize; i++) {
+        val = (record[i / 2] >> (4 * (i % 2))) & 0xF;
+        board -> values[i] = (unsigned char) (val <= 9 ? val : 0);
+    }
+}
+
+/*
+ * Byte Order Functions:
+ * Read and write little-endian integers regardless of the host byte order
+ */
+
+unsigned int readU16(const unsigned char *bytes) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+unsigned int readU32(const unsigned char *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int) bytes[3] << 24);
+}
+
+unsigned long long readU64(const unsigned char *bytes) {
+    return readU32(bytes) | ((unsigned long long) readU32(bytes + 4) << 32);
+}
+
+void writeU16(unsigned char *bytes, unsigned int val) {
+    bytes[0] = (unsigned char) val;
+    bytes[1] = (unsigned char) (val >> 8);
+}
+
+void writeU32(unsigned char *bytes, unsigned int val) {
+    writeU16(bytes, val & 0xFFFF);
+    writeU16(bytes + 2, val >> 16);
+}
+
+void writeU64(unsigned char *bytes, unsigned long long val) {
+    writeU32(bytes, (unsigned int) val);
+    writeU32(bytes + 4, (unsigned int) (val >> 32));
+}
@@ -0,0 +1,114 @@
+//
+// Created on 10/18/26.
+//
+
+#ifndef SUDOKU_SUDOKUPACK_H
+#define SUDOKU_SUDOKUPACK_H
+
+#include <stdio.h>
+#include "SudokuChecker.h"
+
+/*
+ * Packed puzzle file layout (all integers little-endian):
+ * - Header (PackHeaderSize bytes)
+ *      0: magic "SDKP"
+ *      4: u16 format version (PackVersion)
+ *      6: u16 flags (PackSolutions if a solution section follows)
+ *      8: u32 puzzle count
+ *     12: u32 record size (PackRecordSize)
+ *     16: u64 offset of the index
+ *     24: u64 offset of the solution section (0 if none)
+ * - Index: one u64 file offset per puzzle, pointing to its record
+ * - Puzzle records: 81 cells at 4 bits each, cell i in byte i / 2
+ *   (low nibble for even i), 0 for empty
+ * - Solution records: same encoding, solution i at
+ *   solution offset + i * record size. A puzzle with no solution gets a
+ *   record with every cell set to PackNoSolution.
+ */
+#define PackMagic "SDKP"
+#define PackVersion 1
+#define PackSolutions 0x1
+#define PackHeaderSize 32
+#define PackRecordSize ((BoardSize + 1) / 2)
+#define PackNoSolution 0xF
+
+typedef struct Pack Pack;
+typedef struct Writer Writer;
+
+/*
+ * Pack struct:
+ * A packed file mapped into memory with packOpen
+ * - data, size -> the mapped bytes of the whole file
+ * - count -> how many puzzles the file holds
+ * - flags -> the header flags
+ * - index -> start of the offset index
+ * - solutions -> start of the solution section (NULL if none)
+ */
+struct Pack {
+    const unsigned char *data;
+    size_t size;
+    int count;
+    int flags;
+    const unsigned char *index;
+    const unsigned char *solutions;
+};
+
+/*
+ * Reader struct:
+ * Reads the puzzles of a text or packed file a few at a time, so that
+ * a large file never has to be decoded into memory all at once
+ * - pack -> the mapped file, if packed
+ * - file -> the open file, if text
+ * - next -> index of the next puzzle in the file
+ * - end -> index one past the last puzzle to read (-1 to read to the end of a text file)
+ */
+struct Reader {
+    Pack pack;
+    FILE *file;
+    int next;
+    int end;
+};
+
+int isPackFile(const char *path);
+int packOpen(Pack *pack, const char *path);
+void packClose(Pack *pack);
+int packBoard(Pack *pack, int index, Board *board);
+int packSolution(Pack *pack, int index, Board *board);
+
+/*
+ * Writer struct:
+ * Writes a packed file one puzzle at a time. The header and index can only
+ * be written once the count is known, so records are held in temporary
+ * files until writerClose, rather than in memory.
+ * - file -> the packed file being written
+ * - puzzles -> temporary file of the puzzle records
+ * - solutions -> temporary file of the solution records (NULL if none)
+ * - count -> how many puzzles have been added
+ */
+struct Writer {
+    FILE *file;
+    FILE *puzzles;
+    FILE *solutions;
+    int count;
+};
+
+int writerOpen(Writer *writer, FILE *file, int withSolutions);
+int writerAdd(Writer *writer, Board *puzzle, Board *solution);
+int writerClose(Writer *writer);
+int copyFile(FILE *from, FILE *to);
+
+int readerOpen(Reader *reader, const char *path, int first, int count);
+int readerNext(Reader *reader, Board *boards, int max);
+void readerClose(Reader *reader);
+
+void packRecord(Board *board, unsigned char record[PackRecordSize]);
+void unpackRecord(const unsigned char *record, Board *board);
+
+unsigned int readU16(const unsigned char *bytes);    //little-endian byte order helpers
+unsigned int readU32(const unsigned char *bytes);
+unsigned long long readU64(const unsigned char *bytes);
+void writeU16(unsigned char *bytes, unsigned int val);
+void writeU32(unsigned char *bytes, unsigned int val);
+void writeU64(unsigned char *bytes, unsigned long long val);
+
+#endif //SUDOKU_SUDOKUPACK_H
@@ -0,0 +1,403 @@
+/*
+ * SudokuSession:
+ * Incremental solving session for interactive use.
+ * Keeps the candidate notes of a board up to date as single cells are
+ * placed or cleared, and answers "what is the next logical step" queries
+ * without solving the whole board.
+ *
+ * Created on 10/18/26.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "SudokuSession.h"
+#include "SudokuTables.h"
+
+/*
+ * sessionInit:
+ * - Starts a session from the values of a loaded board (see initBoard)
+ * - The filled cells become the givens
+ * - Counts every placed digit in its sets and builds the notes of each empty cell
+ */
+void sessionInit(Session *session, Board *board) {
+    int i, s, val;
+    memset(session -> digitCount, 0, sizeof(session -> digitCount));
+    copyBoard(board, &session -> board);
+    session -> board.guesses = 0;
+    session -> board.depth = 0;
+    memset(session -> board.reasons, 0, sizeof(session -> board.reasons));
+    memset(session -> board.setConflicts, 0, sizeof(session -> board.setConflicts));
+    clearConflict(&session -> board);
+    for (i = 0; i < BoardSize; i++) {
+        val = session -> board.values[i];
+        session -> given[i] = val != 0;
+        if (val != 0) {
+            for (s = 0; s < 3; s++) {
+                session -> digitCount[cellUnits[i][s]][val - 1]++;
+            }
+        }
+    }
+    for (i = 0; i < BoardSize; i++) {
+        sessionRefresh(session, i);
+    }
+}
+
+/*
+ * sessionPlace:
+ * - Places val (1-9) in the cell, replacing any value already there
+ * - Only the cell's sets and peers are updated
+ * - If val is already placed in one of the cell's sets, it is still placed
+ *   (so that it can be cleared again), and the duplicate is recorded in
+ *   board.conflict as a ConflictDuplicate
+ * - Returns -1 if the cell or value is out of range or the cell is a given,
+ *   1 if the value duplicates another, 0 otherwise
+ */
+int sessionPlace(Session *session, int cell, int val) {
+    int i, s, peer, bit;
+    Board *board = &session -> board;
+    if (cell < 0 || cell >= BoardSize || val < 1 || val > 9 || session -> given[cell]) {
+        return -1;
+    }
+    if (board -> values[cell] != 0) {
+        sessionClear(session, cell);
+    }
+    clearConflict(board);
+    for (s = 0; s < 3; s++) {
+        if (session -> digitCount[cellUnits[cell][s]][val - 1]++ == 0 || board -> conflict.type != ConflictNone) {
+            continue;
+        }
+        for (i = 0; i < 9; i++) {
+            peer = units[cellUnits[cell][s]][i];
+            if (board -> values[peer] == val) {
+                recordConflict(board, ConflictDuplicate, cell, peer, cellUnits[cell][s]);
+                break;
+            }
+        }
+    }
+    board -> values[cell] = (unsigned char) val;
+    setEmpty(board, cell);
+
+    bit = 1 << (val - 1);
+    for (i = 0; i < 20; i++) {
+        peer = peers[cell][i];
+        if (board -> notes[peer] & bit) {
+            board -> notes[peer] &= ~bit;
+            board -> noteCount[peer] -= 1;
+        }
+    }
+    return board -> conflict.type == ConflictDuplicate;
+}
+
+/*
+ * sessionClear:
+ * - Empties the cell and retracts its digit from the cell's sets
+ * - The notes of the cell and its peers are rebuilt, since the digit may
+ *   still be placed elsewhere in one of their sets
+ * - Returns -1 if the cell is out of range or is a given, 0 otherwise
+ */
+int sessionClear(Session *session, int cell) {
+    int i, s, val;
+    Board *board = &session -> board;
+    if (cell < 0 || cell >= BoardSize || session -> given[cell]) {
+        return -1;
+    }
+    clearConflict(board);
+    val = board -> values[cell];
+    if (val == 0) {
+        return 0;
+    }
+    for (s = 0; s < 3; s++) {
+        session -> digitCount[cellUnits[cell][s]][val - 1]--;
+    }
+    board -> values[cell] = 0;
+
+    sessionRefresh(session, cell);
+    for (i = 0; i < 20; i++) {
+        sessionRefresh(session, peers[cell][i]);
+    }
+    return 0;
+}
+
+/*
+ * sessionRefresh:
+ * - Rebuilds the notes of a single cell from the digits placed in its sets
+ * - Filled cells are left without notes
+ */
+void sessionRefresh(Session *session, int cell) {
+    int s, n, notes;
+    Board *board = &session -> board;
+    if (board -> values[cell] != 0) {
+        setEmpty(board, cell);
+        return;
+    }
+    notes = AllNotes;
+    for (s = 0; s < 3; s++) {
+        for (n = 0; n < 9; n++) {
+            if (session -> digitCount[cellUnits[cell][s]][n]) {
+                notes &= ~(1 << n);
+            }
+        }
+    }
+    board -> notes[cell] = (unsigned short) notes;
+    board -> noteCount[cell] = (unsigned char) countNotes(notes);
+}
+
+/*
+ * sessionHint:
+ * - Finds the single next deduction on the board without changing the session
+ * Description:
+ * 1. Check the board for a contradiction (see findContradiction), since no
+ *    step can be trusted on a board without a solution
+ * 2. Look for a naked or hidden single on the current notes
+ * 3. If there is none, apply naked groups (see groupCheck) to a scratch copy
+ *    of the board one group at a time, until a single or a contradiction appears
+ * 4. The group whose eliminations revealed the single is named in the hint
+ *    (groups applied before it may also have been needed)
+ * - Returns 0 and fills in hint if a step was found
+ * - Returns 1 and fills in a HintContradiction if the board has no solution
+ * - Returns -1 if the board cannot be progressed without guessing
+ */
+int sessionHint(Session *session, Hint *hint) {
+    int set, first, members, check;
+    Board scratch;
+    hint -> set = -1;
+    hint -> members = 0;
+    hint -> notes = 0;
+    hint -> conflict = ConflictNone;
+    if (findContradiction(&session -> board, hint) == 0) {
+        return 1;
+    }
+    if (findSingle(&session -> board, hint) == 0) {
+        return 0;
+    }
+    copyBoard(&session -> board, &scratch);
+    do {
+        check = 0;
+        for (set = 0; set < 27; set++) {
+            for (first = findGroup(&scratch, set, 0, &members); first != -1;
+                 first = findGroup(&scratch, set, first + 1, &members)) {
+                if (!groupCancel(&scratch, set, members, scratch.notes[units[set][first]])) {
+                    continue;
+                }
+                check = 1;
+                if (findContradiction(&scratch, hint) == 0) {
+                    return 1;
+                }
+                if (findSingle(&scratch, hint) == 0) {
+                    hint -> technique = HintNakedGroup;
+                    hint -> set = set;
+                    hint -> members = members;
+                    hint -> notes = scratch.notes[units[set][first]];
+                    return 0;
+                }
+            }
+        }
+    } while (check);
+
+    hint -> technique = HintNone;
+    hint -> cell = -1;
+    hint -> value = 0;
+    return -1;
+}
+
+/*
+ * findGroup:
+ * - Looks for a naked group in the set, starting from position first:
+ *   n empty cells that share the same n notes
+ * - Each group is only found from its lowest position
+ * - Returns that position and sets members to the group's positions (0-8),
+ *   or returns -1 if there are no more groups
+ */
+int findGroup(Board *board, int set, int first, int *members) {
+    const unsigned char *cells = units[set];
+    int i, n, count;
+    for (i = first; i < 9; i++) {
+        if (board -> values[cells[i]] != 0 || board -> noteCount[cells[i]] < 2) {
+            continue;
+        }
+        count = 0;
+        *members = 0;
+        for (n = 0; n < 9; n++) {
+            if (board -> values[cells[n]] == 0 && board -> notes[cells[n]] == board -> notes[cells[i]]) {
+                *members |= 1 << n;
+                count++;
+            }
+        }
+        if (count == board -> noteCount[cells[i]] && !(*members & ((1 << i) - 1))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * findContradiction:
+ * - Looks for a value placed twice in a set, then for an empty cell with no
+ *   notes, then for a value with no cell left in a set
+ * - Returns 0 and fills in a HintContradiction if one was found, -1 otherwise
+ */
+int findContradiction(Board *board, Hint *hint) {
+    int i, n, set, cell, val, placed, notes;
+    hint -> technique = HintContradiction;
+    for (set = 0; set < 27; set++) {
+        placed = 0;
+        for (i = 0; i < 9; i++) {
+            val = board -> values[units[set][i]];
+            if (val != 0 && (placed & (1 << (val - 1)))) {
+                for (n = 0; board -> values[units[set][n]] != val; n++);
+                hint -> conflict = ConflictDuplicate;
+                hint -> cell = units[set][i];
+                hint -> value = val;
+                hint -> set = set;
+                hint -> members = (1 << n) | (1 << i);
+                return 0;
+            }
+            placed |= val != 0 ? 1 << (val - 1) : 0;
+        }
+    }
+    for (cell = 0; cell < BoardSize; cell++) {
+        if (board -> values[cell] == 0 && board -> noteCount[cell] == 0) {
+            hint -> conflict = ConflictNoNotes;
+            hint -> cell = cell;
+            hint -> value = 0;
+            return 0;
+        }
+    }
+    for (set = 0; set < 27; set++) {
+        placed = notes = 0;
+        for (i = 0; i < 9; i++) {
+            cell = units[set][i];
+            if (board -> values[cell] != 0) {
+                placed |= 1 << (board -> values[cell] - 1);
+            } else {
+                notes |= board -> notes[cell];
+            }
+        }
+        if ((placed | notes) != AllNotes) {
+            hint -> conflict = ConflictNoPlace;
+            hint -> cell = -1;
+            hint -> value = firstNote(AllNotes & ~(placed | notes)) + 1;
+            hint -> set = set;
+            return 0;
+        }
+    }
+    hint -> technique = HintNone;
+    return -1;
+}
+
+/*
+ * findSingle:
+ * - Looks for an empty cell with only one note (naked single), then for a
+ *   note that only appears in one cell of a set (hidden single)
+ * - Returns 0 and fills in hint if one was found, -1 otherwise
+ */
+int findSingle(Board *board, Hint *hint) {
+    int i, n, set, loc, count;
+    for (i = 0; i < BoardSize; i++) {
+        if (board -> values[i] == 0 && board -> noteCount[i] == 1) {
+            hint -> technique = HintNakedSingle;
+            hint -> cell = i;
+            hint -> value = firstNote(board -> notes[i]) + 1;
+            return 0;
+        }
+    }
+    for (set = 0; set < 27; set++) {
+        for (n = 0; n < 9; n++) {
+            count = loc = 0;
+            for (i = 0; i < 9; i++) {
+                if (board -> notes[units[set][i]] & (1 << n)) {
+                    count++;
+                    loc = units[set][i];
+                    if (count > 1) {
+                        break;
+                    }
+                }
+            }
+            if (count == 1) {
+                hint -> technique = HintHiddenSingle;
+                hint -> cell = loc;
+                hint -> value = n + 1;
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+/*
+ * writeHint:
+ * - Writes a hint as one line, e.g. "Naked Single: r4c7 = 2", with rows and
+ *   columns counted from 1
+ * - Naked group hints also list the group's cells and digits, and its set
+ * - Contradictions name the cell, or the value and set, that cannot be satisfied
+ */
+void writeHint(Hint *hint, FILE *file) {
+    int i, n;
+    if (hint -> technique == HintNone) {
+        fprintf(file, "No Hint: the board cannot be progressed without guessing\n");
+        return;
+    }
+    if (hint -> technique == HintContradiction) {
+        fprintf(file, "%s: ", hintName(hint -> technique));
+        switch (hint -> conflict) {
+            case ConflictDuplicate:
+                fprintf(file, "%d is placed twice in ", hint -> value);
+                writeSet(hint -> set, file);
+                break;
+            case ConflictNoNotes:
+                fprintf(file, "r%dc%d has no digit left", hint -> cell / 9 + 1, hint -> cell % 9 + 1);
+                break;
+            default:
+                fprintf(file, "%d has no cell left in ", hint -> value);
+                writeSet(hint -> set, file);
+                break;
+        }
+        fputc('\n', file);
+        return;
+    }
+    fprintf(file, "%s: r%dc%d = %d", hintName(hint -> technique),
+            hint -> cell / 9 + 1, hint -> cell % 9 + 1, hint -> value);
+    if (hint -> technique == HintNakedGroup) {
+        fprintf(file, " (");
+        for (i = 0; i < 9; i++) {
+            if (hint -> members & (1 << i)) {
+                fprintf(file, "r%dc%d ", units[hint -> set][i] / 9 + 1, units[hint -> set][i] % 9 + 1);
+            }
+        }
+        fprintf(file, "hold");
+        for (n = 0; n < 9; n++) {
+            if (hint -> notes & (1 << n)) {
+                fprintf(file, " %d", n + 1);
+            }
+        }
+        fprintf(file, " in ");
+        writeSet(hint -> set, file);
+        fputc(')', file);
+    }
+    fputc('\n', file);
+}
+
+/*
+ * writeSet: Writes a set (0-26) by name, e.g. "column 4", counting from 1
+ */
+void writeSet(int set, FILE *file) {
+    fprintf(file, "%s %d", set < 9 ? "row" : set < 18 ? "column" : "square", set % 9 + 1);
+}
+
+/*
+ * hintName: Returns a printable name for a hint technique
+ */
+const char *hintName(int technique) {
+    switch (technique) {
+        case HintNakedSingle:
+            return "Naked Single";
+        case HintHiddenSingle:
+            return "Hidden Single";
+        case HintNakedGroup:
+            return "Naked Group";
+        case HintContradiction:
+            return "Contradiction";
+        default:
+            return "None";
+    }
+}
@@ -0,0 +1,77 @@
+//
+// Created on 10/18/26.
+//
+
+#ifndef SUDOKU_SUDOKUSESSION_H
+#define SUDOKU_SUDOKUSESSION_H
+
+#include <stdio.h>
+#include "SudokuChecker.h"
+
+/*
+ * Hint techniques, in the order the hint search tries them
+ */
+#define HintNone 0
+#define HintNakedSingle 1
+#define HintHiddenSingle 2
+#define HintNakedGroup 3
+#define HintContradiction 4    //the board has no solution (see Hint struct)
+
+typedef struct Session Session;
+typedef struct Hint Hint;
+
+/*
+ * Session struct:
+ * Keeps the candidate state of a board alive between edits, so that
+ * placing or clearing one digit only touches the cell and its 20 peers.
+ * - board -> the current values and notes (notes are only kept for empty cells).
+ *   board.conflict holds the duplicate made by the last sessionPlace, if any.
+ * - given -> 1 for the cells filled by the puzzle, which cannot be edited
+ * - digitCount -> how many times each digit (0-8) is placed in each of the 27 sets.
+ *   Counts rather than flags let a clear retract a digit correctly even if
+ *   the same digit was placed twice in one set.
+ */
+struct Session {
+    Board board;
+    unsigned char given[BoardSize];
+    unsigned char digitCount[27][9];
+};
+
+/*
+ * Hint struct:
+ * - technique -> one of the Hint* values above
+ * - cell -> index (0-80) of the cell that can be filled
+ * - value -> the 1-9 value that goes in the cell
+ * - set -> for HintNakedGroup, the set (0-26) holding the group that revealed
+ *   the single, otherwise -1
+ * - members -> for HintNakedGroup, bitmask of the group's positions (0-8) in set
+ * - notes -> for HintNakedGroup, the digits the group holds (bit n for n + 1)
+ * - conflict -> for HintContradiction, one of the Conflict* types, otherwise ConflictNone:
+ *      ConflictDuplicate -> value is placed twice in set, at the positions in members
+ *      ConflictNoNotes -> the empty cell has no notes left
+ *      ConflictNoPlace -> value has no cell left in set
+ */
+struct Hint {
+    int technique;
+    int cell;
+    int value;
+    int set;
+    int members;
+    int notes;
+    int conflict;
+};
+
+void sessionInit(Session *session, Board *board);
+int sessionPlace(Session *session, int cell, int val);
+int sessionClear(Session *session, int cell);
+int sessionHint(Session *session, Hint *hint);
+const char *hintName(int technique);
+
+void sessionRefresh(Session *session, int cell);
+int findContradiction(Board *board, Hint *hint);
+int findSingle(Board *board, Hint *hint);
+int findGroup(Board *board, int set, int first, int *members);
+void writeHint(Hint *hint, FILE *file);
+void writeSet(int set, FILE *file);
+
+#endif //SUDOKU_SUDOKUSESSION_H
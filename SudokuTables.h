@@ -0,0 +1,23 @@
+//
+// Created on 10/18/26.
+//
+
+#ifndef SUDOKU_SUDOKUTABLES_H
+#define SUDOKU_SUDOKUTABLES_H
+
+/*
+ * Static board topology:
+ * Cells are numbered 0-80 in row-major order (index = 9 * row + col).
+ * Every table is fixed at compile time in SudokuTables.c, so nothing has to be
+ * built when the program starts.
+ *
+ * - units -> the 27 sets of cells that must each hold 1-9 once.
+ *   0-8 rows, 9-17 columns, 18-26 squares
+ * - cellUnits -> the row, column, and square unit of each cell
+ * - peers -> the 20 other cells that share a unit with each cell
+ */
+extern const unsigned char units[27][9];
+extern const unsigned char cellUnits[BoardSize][3];
+extern const unsigned char peers[BoardSize][20];
+
+#endif //SUDOKU_SUDOKUTABLES_H
@@ -0,0 +1,290 @@
+/*
+ * SudokuTrace:
+ * Opt-in tracer for profiling the search on hard puzzles.
+ * Records branch points, guesses, backtracks, and propagation phases into a
+ * ring buffer, and exports them as Chrome trace-event JSON (chrome://tracing,
+ * Perfetto) or as a compact binary log.
+ *
+ * Created on 10/18/26.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "SudokuTrace.h"
+#include "SudokuPack.h"
+
+/*
+ * activeTrace:
+ * The trace that the solver records into, NULL while tracing is off
+ */
+Trace *activeTrace = NULL;
+
+/*
+ * traceStart:
+ * - Allocates a ring buffer of at least capacity events and starts recording
+ * - A trace that is already recording is stopped and freed first
+ * - Returns -1 if the buffer could not be allocated
+ */
+int traceStart(unsigned long long capacity) {
+    Trace *trace;
+    unsigned long long size = 1;
+    traceFree(traceStop());
+    while (size < capacity) {
+        size <<= 1;
+    }
+    trace = (Trace*) malloc(sizeof(Trace));
+    if (!trace) {
+        return -1;
+    }
+    trace -> events = (TraceEvent*) malloc(size * sizeof(TraceEvent));
+    if (!trace -> events) {
+        free(trace);
+        return -1;
+    }
+    trace -> capacity = size;
+    trace -> total = 0;
+    trace -> depth = 0;
+    trace -> puzzle = 0;
+    trace -> start = traceClock();
+    activeTrace = trace;
+    return 0;
+}
+
+/*
+ * traceStop:
+ * - Stops recording and hands the trace back to the caller for export
+ */
+Trace *traceStop() {
+    Trace *trace = activeTrace;
+    activeTrace = NULL;
+    return trace;
+}
+
+void traceFree(Trace *trace) {
+    if (trace) {
+        free(trace -> events);
+        free(trace);
+    }
+}
+
+/*
+ * traceClock: Returns the current monotonic time in nanoseconds
+ */
+unsigned long long traceClock() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/*
+ * Record Functions:
+ * Only called through the TRACE macro, so activeTrace is never NULL here
+ */
+
+/*
+ * traceNext:
+ * - Claims the next ring buffer slot, overwriting the oldest event once full
+ */
+TraceEvent *traceNext() {
+    TraceEvent *event;
+    event = &activeTrace -> events[activeTrace -> total & (activeTrace -> capacity - 1)];
+    activeTrace -> total++;
+    event -> time = traceClock() - activeTrace -> start;
+    event -> duration = 0;
+    event -> notes = 0;
+    event -> cell = 0;
+    event -> value = 0;
+    event -> phase = 0;
+    event -> depth = (unsigned short) activeTrace -> depth;
+    event -> puzzle = activeTrace -> puzzle;
+    return event;
+}
+
+/*
+ * traceBegin:
+ * - Marks the start of a puzzle, so that every event up to the matching
+ *   traceEnd is tagged with its index
+ */
+void traceBegin(int puzzle) {
+    TraceEvent *event;
+    activeTrace -> puzzle = (unsigned int) puzzle;
+    activeTrace -> depth = 0;
+    event = traceNext();
+    event -> type = TraceBegin;
+}
+
+void traceEnd(int solved) {
+    TraceEvent *event = traceNext();
+    event -> type = TraceEnd;
+    event -> value = (unsigned char) (solved != 0);
+}
+
+/*
+ * traceBranch:
+ * - Records the cell guess() branches on and its candidates
+ * - The search is one level deeper until the matching traceLeave
+ */
+void traceBranch(int cell, int notes) {
+    TraceEvent *event;
+    activeTrace -> depth++;
+    event = traceNext();
+    event -> type = TraceBranch;
+    event -> cell = (unsigned char) cell;
+    event -> notes = (unsigned short) notes;
+}
+
+void traceGuess(int cell, int value) {
+    TraceEvent *event = traceNext();
+    event -> type = TraceGuess;
+    event -> cell = (unsigned char) cell;
+    event -> value = (unsigned char) value;
+}
+
+void traceBacktrack(int cell, int value) {
+    TraceEvent *event = traceNext();
+    event -> type = TraceBacktrack;
+    event -> cell = (unsigned char) cell;
+    event -> value = (unsigned char) value;
+}
+
+void traceLeave() {
+    activeTrace -> depth--;
+}
+
+/*
+ * tracePhase:
+ * - Records a propagation phase that began at start (a traceClock reading)
+ */
+void tracePhase(int phase, unsigned long long start) {
+    TraceEvent *event = traceNext();
+    event -> type = TracePhase;
+    event -> phase = (unsigned char) phase;
+    event -> duration = (unsigned int) (event -> time - (start - activeTrace -> start));
+    event -> time = start - activeTrace -> start;
+}
+
+/*
+ * Export Functions
+ */
+
+/*
+ * traceWriteJson:
+ * - Writes the events still in the ring buffer as Chrome trace-event JSON
+ * - Each puzzle gets its own track (tid puzzle + 1), named when it begins,
+ *   with begin/end ("B"/"E") events around its solve
+ * - Phases become complete ("X") events, everything else instant ("i") events
+ * - Returns -1 if the file could not be written
+ */
+int traceWriteJson(Trace *trace, FILE *file) {
+    unsigned long long i, first, tid;
+    TraceEvent *event;
+    int n, comma;
+    first = trace -> total > trace -> capacity ? trace -> total - trace -> capacity : 0;
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%llu},\"traceEvents\":[",
+            first);
+    comma = 0;
+    for (i = first; i < trace -> total; i++) {
+        event = &trace -> events[i & (trace -> capacity - 1)];
+        fprintf(file, "%s\n", comma ? "," : "");
+        comma = 1;
+        tid = event -> puzzle + 1ULL;
+        if (event -> type == TraceBegin) {
+            fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%llu,"
+                          "\"args\":{\"name\":\"Puzzle %u\"}},\n",
+                    tid, event -> puzzle);
+            fprintf(file, "{\"name\":\"solve\",\"ph\":\"B\",\"pid\":1,\"tid\":%llu,"
+                          "\"ts\":%.3f,\"args\":{\"puzzle\":%u}}",
+                    tid, event -> time / 1000.0, event -> puzzle);
+            continue;
+        }
+        if (event -> type == TraceEnd) {
+            fprintf(file, "{\"name\":\"solve\",\"ph\":\"E\",\"pid\":1,\"tid\":%llu,"
+                          "\"ts\":%.3f,\"args\":{\"solved\":%s}}",
+                    tid, event -> time / 1000.0, event -> value ? "true" : "false");
+            continue;
+        }
+        if (event -> type == TracePhase) {
+            fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%llu,"
+                          "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%d}}",
+                    phaseName(event -> phase), tid, event -> time / 1000.0,
+                    event -> duration / 1000.0, event -> depth);
+            continue;
+        }
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%llu,"
+                      "\"ts\":%.3f,\"args\":{\"depth\":%d,\"row\":%d,\"col\":%d",
+                event -> type == TraceBranch ? "Branch" :
+                event -> type == TraceGuess ? "Guess" : "Backtrack",
+                tid, event -> time / 1000.0, event -> depth, event -> cell / 9, event -> cell % 9);
+        if (event -> type == TraceBranch) {
+            fprintf(file, ",\"candidates\":[");
+            for (n = 0; n < 9; n++) {
+                if (event -> notes & (1 << n)) {
+                    fprintf(file, "%s%d", (event -> notes & ((1 << n) - 1)) ? "," : "", n + 1);
+                }
+            }
+            fputc(']', file);
+        } else {
+            fprintf(file, ",\"value\":%d", event -> value);
+        }
+        fprintf(file, "}}");
+    }
+    fprintf(file, "\n]}\n");
+    return ferror(file) ? -1 : 0;
+}
+
+/*
+ * traceWriteLog:
+ * - Writes the events still in the ring buffer as a compact binary log
+ *   (all integers little-endian)
+ *      header: magic "SDKT", u16 version, u16 event size, u32 event count,
+ *              u64 dropped event count
+ *      event: u64 time, u32 duration, u16 notes, u8 type, u8 cell,
+ *             u8 value, u8 phase, u16 depth, u32 puzzle
+ * - Returns -1 if the file could not be written
+ */
+int traceWriteLog(Trace *trace, FILE *file) {
+    unsigned long long i, first;
+    unsigned char header[20], bytes[TraceLogEventSize];
+    TraceEvent *event;
+    first = trace -> total > trace -> capacity ? trace -> total - trace -> capacity : 0;
+
+    header[0] = TraceLogMagic[0];
+    header[1] = TraceLogMagic[1];
+    header[2] = TraceLogMagic[2];
+    header[3] = TraceLogMagic[3];
+    writeU16(header + 4, TraceLogVersion);
+    writeU16(header + 6, TraceLogEventSize);
+    writeU32(header + 8, (unsigned int) (trace -> total - first));
+    writeU64(header + 12, first);
+    fwrite(header, 1, sizeof(header), file);
+
+    for (i = first; i < trace -> total; i++) {
+        event = &trace -> events[i & (trace -> capacity - 1)];
+        writeU64(bytes, event -> time);
+        writeU32(bytes + 8, event -> duration);
+        writeU16(bytes + 12, event -> notes);
+        bytes[14] = event -> type;
+        bytes[15] = event -> cell;
+        bytes[16] = event -> value;
+        bytes[17] = event -> phase;
+        writeU16(bytes + 18, event -> depth);
+        writeU32(bytes + 20, event -> puzzle);
+        fwrite(bytes, 1, TraceLogEventSize, file);
+    }
+    return ferror(file) ? -1 : 0;
+}
+
+/*
+ * phaseName: Returns a printable name for a propagation phase
+ */
+const char *phaseName(int phase) {
+    switch (phase) {
+        case PhaseUpdate:
+            return "updateAll";
+        case PhaseSolve:
+            return "solveAll";
+        default:
+            return "Unknown";
+    }
+}
@@ -0,0 +1,110 @@
+//
+// Created on 10/18/26.
+//
+
+#ifndef SUDOKU_SUDOKUTRACE_H
+#define SUDOKU_SUDOKUTRACE_H
+
+#include <stdio.h>
+
+#define TraceCapacity 65536
+
+/*
+ * Event types
+ */
+#define TraceBranch 1       //guess() picked a cell to branch on
+#define TraceGuess 2        //a value was tried in the branch cell
+#define TraceBacktrack 3    //a tried value failed and the board was restored
+#define TracePhase 4        //one propagation phase ran (see below)
+#define TraceBegin 5        //solving of a puzzle started
+#define TraceEnd 6          //solving of a puzzle finished
+
+/*
+ * Propagation phases
+ */
+#define PhaseUpdate 1       //updateAll
+#define PhaseSolve 2        //solveAll
+
+#define TraceLogMagic "SDKT"
+#define TraceLogVersion 2
+#define TraceLogEventSize 24
+
+/*
+ * TRACE:
+ * Runs a tracer call only while a trace is active, so an idle tracer costs
+ * one pointer test. Building with -DSUDOKU_NO_TRACE removes the calls entirely,
+ * while still type checking them.
+ */
+#ifdef SUDOKU_NO_TRACE
+#define TRACE(call) do { if (0) { call; } } while (0)
+#else
+#define TRACE(call) do { if (activeTrace) { call; } } while (0)
+#endif
+
+typedef struct TraceEvent TraceEvent;
+typedef struct Trace Trace;
+
+/*
+ * TraceEvent struct:
+ * - time -> nanoseconds since traceStart (start time for phases)
+ * - duration -> nanoseconds the phase ran for (phases only)
+ * - notes -> candidate bitmask of the branch cell
+ * - type -> one of the Trace* event types
+ * - cell -> index (0-80) of the branch cell
+ * - value -> the 1-9 value guessed or backtracked (for TraceEnd, 1 if the puzzle was solved)
+ * - phase -> one of the Phase* values
+ * - depth -> how many guesses deep the search was
+ * - puzzle -> index of the puzzle being solved in its input file
+ */
+struct TraceEvent {
+    unsigned long long time;
+    unsigned int duration;
+    unsigned short notes;
+    unsigned char type;
+    unsigned char cell;
+    unsigned char value;
+    unsigned char phase;
+    unsigned short depth;
+    unsigned int puzzle;
+};
+
+/*
+ * Trace struct:
+ * Ring buffer of the most recent events. Once full, the oldest events
+ * are overwritten and counted as dropped when exported.
+ * - events -> capacity slots, capacity is a power of two
+ * - total -> how many events have been recorded since traceStart
+ * - start -> clock reading at traceStart
+ * - depth -> current guess depth
+ * - puzzle -> index of the puzzle being solved, set by traceBegin
+ */
+struct Trace {
+    TraceEvent *events;
+    unsigned long long capacity;
+    unsigned long long total;
+    unsigned long long start;
+    int depth;
+    unsigned int puzzle;
+};
+
+extern Trace *activeTrace;
+
+int traceStart(unsigned long long capacity);
+Trace *traceStop();
+void traceFree(Trace *trace);
+
+unsigned long long traceClock();
+TraceEvent *traceNext();
+void traceBegin(int puzzle);
+void traceEnd(int solved);
+void traceBranch(int cell, int notes);
+void traceGuess(int cell, int value);
+void traceBacktrack(int cell, int value);
+void traceLeave();
+void tracePhase(int phase, unsigned long long start);
+
+int traceWriteJson(Trace *trace, FILE *file);
+int traceWriteLog(Trace *trace, FILE *file);
+const char *phaseName(int phase);
+
+#endif //SUDOKU_SUDOKUTRACE_H